@@ -0,0 +1,47 @@
+// include/backoffice/csv_ticket_loader.h
+#ifndef CSV_TICKET_LOADER_H
+#define CSV_TICKET_LOADER_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "ticket.h"
+#include "ticket_store.h"
+
+/**
+ * @brief Parallel loader for CSV stock files and journals
+ *
+ * The file is mapped with mmap and cut into one chunk per thread on line
+ * boundaries. Each thread parses its chunk in place (string_view fields,
+ * std::from_chars for numbers) and buckets the tickets by store shard;
+ * the buckets are then merged shard by shard, again in parallel. Rows
+ * keep their file order within a shard, so the first copy of a duplicated
+ * ID wins as with a sequential load.
+ */
+class CsvTicketLoader {
+public:
+    struct Stats {
+        size_t rows = 0;        // Well-formed rows parsed
+        size_t badRows = 0;     // Malformed rows skipped
+        size_t duplicates = 0;  // Rows whose ID was already in the store
+        double seconds = 0.0;
+
+        double rowsPerSecond() const { return seconds > 0.0 ? rows / seconds : 0.0; }
+    };
+
+    // threadCount 0 uses one thread per core
+    explicit CsvTicketLoader(size_t threadCount = 0);
+
+    // Parse the file and merge it into the store; false if it cannot be opened
+    bool loadInto(const std::string& path, TicketStore& store, Stats& stats) const;
+
+    // Parse the file into tickets in file order; false if it cannot be opened
+    bool load(const std::string& path, std::vector<Ticket>& tickets, Stats& stats) const;
+
+    size_t threadCount() const { return threadCount_; }
+
+private:
+    size_t threadCount_;
+};
+
+#endif // CSV_TICKET_LOADER_H
@@ -0,0 +1,80 @@
+// include/backoffice/fault_injector.h
+#ifndef FAULT_INJECTOR_H
+#define FAULT_INJECTOR_H
+
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <random>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+/**
+ * @brief Latency and failure simulation for the back-office endpoints
+ *
+ * Replaces the hardcoded sleeps and the 10% random failure. Every endpoint
+ * has its own latency distribution and error rate; draws come from one
+ * seeded generator so a run can be replayed with the same seed.
+ *
+ * Disabled by default: inject() is then a single relaxed atomic load, so
+ * production and benchmark runs measure the real code.
+ *
+ * Configured from a spec string (command line / BACKOFFICE_FAULTS):
+ *   "seed=42;create:latency=100;validate:latency=150-250,error=0.1"
+ * latency=<ms> is fixed, <min>-<max> uniform, <mean>~<stddev> normal.
+ * At runtime the same settings are exchanged as JSON (toJson/fromJson).
+ */
+class FaultInjector {
+public:
+    enum class Endpoint { Create, Validate, Report };
+    static constexpr int kEndpointCount = 3;
+
+    struct Profile {
+        enum class Latency { None, Fixed, Uniform, Normal };
+
+        Latency latency = Latency::None;
+        double latencyMs = 0.0;     // Fixed value, uniform minimum or normal mean
+        double latencyMaxMs = 0.0;  // Uniform maximum or normal standard deviation
+        double errorRate = 0.0;     // Probability of a simulated failure
+    };
+
+    struct Config {
+        bool enabled = false;
+        uint64_t seed = 0;
+        Profile endpoints[kEndpointCount];
+    };
+
+    FaultInjector();
+
+    // Apply the simulated latency for the endpoint and throw
+    // std::runtime_error when a failure is drawn
+    void inject(Endpoint endpoint) {
+        if (!enabled_.load(std::memory_order_relaxed)) return;
+        injectSlow(endpoint);
+    }
+
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    void configure(const Config& config);
+    Config config() const;
+
+    // Throws std::invalid_argument on malformed input
+    static Config parseSpec(const std::string& spec);
+    static Config fromJson(const json& j);
+    static json toJson(const Config& config);
+
+    static const char* endpointName(Endpoint endpoint);
+
+private:
+    std::atomic<bool> enabled_;
+    mutable std::mutex mutex_;
+    Config config_;
+    std::mt19937_64 generator_;
+
+    void injectSlow(Endpoint endpoint);
+};
+
+#endif // FAULT_INJECTOR_H
@@ -0,0 +1,39 @@
+// include/backoffice/ticket_csv.h
+#ifndef TICKET_CSV_H
+#define TICKET_CSV_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include "ticket.h"
+
+/**
+ * @brief CSV layout of the ticket stock file and journal
+ *
+ * One ticket per row: TicketID,CreationDate,ValidityDays,LineNumber, with
+ * the creation date as "YYYY-MM-DDTHH:MM:SS" in UTC.
+ * Snapshots start with that header line, journal files do not.
+ * Files are read with CsvTicketLoader.
+ */
+class TicketCsv {
+public:
+    static const char* const kHeader;
+
+    // Fields of one row; the ID points into the parsed line
+    struct Row {
+        std::string_view ticketId;
+        int64_t creationTime = 0;  // Seconds since the Unix epoch
+        int validityDays = 0;
+        int lineNumber = 0;
+    };
+
+    static std::string formatRow(const Ticket& ticket);
+
+    // Parse one row without allocating; false for malformed rows
+    static bool parseRow(std::string_view line, Row& row);
+
+    static void writeFile(const std::string& path, const std::vector<Ticket>& tickets);
+};
+
+#endif // TICKET_CSV_H
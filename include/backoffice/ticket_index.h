@@ -0,0 +1,69 @@
+// include/backoffice/ticket_index.h
+#ifndef TICKET_INDEX_H
+#define TICKET_INDEX_H
+
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Open-addressing hash index from ticket ID to store position
+ *
+ * Slots hold the 64-bit hash of the ID and the position of the ticket in
+ * the owning container; the IDs themselves are not copied. Lookups compare
+ * the hash first and only then ask the container whether the ticket at
+ * that position has the wanted ID (matches(position)), so a lookup never
+ * allocates and the container may keep IDs in any form.
+ *
+ * Linear probing over a power-of-two table kept at most 70% full.
+ * Not thread-safe: the owner serializes writers against readers.
+ */
+class TicketIndex {
+public:
+    static constexpr uint32_t kNotFound = UINT32_MAX;
+
+    explicit TicketIndex(size_t expectedTickets = 0);
+
+    // 64-bit hash of a ticket ID (FNV-1a with a murmur finalizer)
+    static uint64_t hash(std::string_view id);
+
+    // Position of the ticket with this hash for which matches(position)
+    // is true (the owner compares the stored ID), or kNotFound
+    template <typename Matches>
+    uint32_t findMatching(uint64_t idHash, Matches&& matches) const {
+        if (size_ == 0) return kNotFound;
+
+        for (size_t i = idHash & mask_;; i = (i + 1) & mask_) {
+            const Slot& slot = slots_[i];
+            if (slot.position == kNotFound) return kNotFound;
+            if (slot.hash == idHash && matches(slot.position)) {
+                return slot.position;
+            }
+        }
+    }
+
+    // Index a position whose ID the caller knows is not indexed yet
+    void insertUnique(uint64_t idHash, uint32_t position);
+
+    void reserve(size_t expectedTickets);
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return slots_.size(); }
+
+private:
+    struct Slot {
+        uint64_t hash;
+        uint32_t position;
+    };
+
+    std::vector<Slot> slots_;
+    size_t mask_;
+    size_t size_;
+
+    void rehash(size_t slotCount);
+
+    static size_t slotsFor(size_t tickets);
+};
+
+#endif // TICKET_INDEX_H
@@ -0,0 +1,121 @@
+// include/backoffice/ticket_journal.h
+#ifndef TICKET_JOURNAL_H
+#define TICKET_JOURNAL_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <set>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Append-only ticket journal with group commit
+ *
+ * Sales are appended as CSV rows (see TicketCsv) to "<snapshot>.journal"
+ * instead of rewriting the whole stock file. A single flusher thread writes
+ * every row queued since its last write and issues one fdatasync for the
+ * whole batch, so concurrent sales share the cost of a disk flush.
+ *
+ * A compaction thread rolls the journal into a fresh snapshot once enough
+ * records have accumulated: the journal is rotated to "<journal>.old",
+ * the snapshot is rewritten from the in-memory store and the old journal
+ * is removed. On startup the snapshot is loaded first and then every path
+ * returned by replayPaths(); duplicated rows must be ignored by the loader.
+ *
+ * Sales use append(rows, apply): the rows are made durable first and apply
+ * (the store insert) runs afterwards, so a ticket whose row could not be
+ * written never becomes visible. A compaction waits for the apply of every
+ * row in the journal it rotated out, so its snapshot still covers them.
+ */
+class TicketJournal {
+public:
+    // Writes a complete snapshot of the store to the given path
+    using SnapshotWriter = std::function<void(const std::string& path)>;
+    // Makes durable rows visible, e.g. inserts their tickets into the store
+    using Apply = std::function<void()>;
+
+    struct Stats {
+        uint64_t records = 0;      // Rows made durable
+        uint64_t flushes = 0;      // fdatasync calls (one per group commit)
+        uint64_t compactions = 0;  // Completed snapshot rewrites
+    };
+
+    static constexpr size_t kDefaultCompactionThreshold = 100000;
+
+    TicketJournal(const std::string& snapshotPath, SnapshotWriter snapshotWriter,
+                  size_t compactionThreshold = kDefaultCompactionThreshold);
+    ~TicketJournal();
+
+    TicketJournal(const TicketJournal&) = delete;
+    TicketJournal& operator=(const TicketJournal&) = delete;
+
+    // Journal files to replay after the snapshot, oldest first
+    std::vector<std::string> replayPaths() const;
+
+    // Open the journal for appending and start the background threads.
+    // Must be called after the store has been loaded from disk.
+    void open();
+    void close();
+
+    // Append rows and block until they are durable on disk
+    void append(const std::string& row);
+    void append(const std::vector<std::string>& rows);
+    // Same, then run apply. Throws without calling apply when the rows
+    // could not be written; exceptions from apply are passed on.
+    void append(const std::vector<std::string>& rows, const Apply& apply);
+
+    // Roll the journal into a fresh snapshot (synchronous)
+    void compact();
+
+    Stats stats() const;
+
+    const std::string& snapshotPath() const { return snapshotPath_; }
+    const std::string& journalPath() const { return journalPath_; }
+
+private:
+    std::string snapshotPath_;
+    std::string journalPath_;
+    std::string rotatedPath_;
+    SnapshotWriter snapshotWriter_;
+    size_t compactionThreshold_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable flushCv_;
+    std::condition_variable durableCv_;
+    std::condition_variable compactCv_;
+    std::condition_variable appliedCv_;
+
+    int fd_;                       // Owned by the flusher thread once open
+    std::string pending_;          // Rows waiting for the next group commit
+    size_t pendingRecords_;
+    uint64_t appendedBatches_;
+    uint64_t durableBatches_;
+    size_t recordsSinceCompaction_;
+    bool rotateRequested_;
+    bool rotateDone_;
+    uint64_t rotatedBatches_;      // Batches in the journal last rotated out
+    std::set<uint64_t> applying_;  // Batches whose apply has not finished
+    bool running_;
+    std::string writeError_;
+    Stats stats_;
+
+    std::mutex compactMutex_;      // Serializes compactions
+    std::thread flusher_;
+    std::thread compactor_;
+
+    void flushLoop();
+    void compactLoop();
+    void requestRotation();
+    void rotateFiles();
+    void writeSnapshot();
+    void openJournalFile();
+
+    static bool fileExists(const std::string& path);
+    static void syncParentDirectory(const std::string& path);
+};
+
+#endif // TICKET_JOURNAL_H
@@ -0,0 +1,96 @@
+// include/backoffice/ticket_snapshot.h
+#ifndef TICKET_SNAPSHOT_H
+#define TICKET_SNAPSHOT_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "ticket.h"
+#include "ticket_record.h"
+#include "ticket_store.h"
+
+/**
+ * @brief Fixed-width binary ticket snapshot, read through mmap
+ *
+ * Layout (native little-endian):
+ * - 64-byte header: magic "TKTSNAP\0", format version, record size,
+ *   record count, size of the long ID area
+ * - recordCount records of 64 bytes each
+ * - the long ID area: IDs longer than a record's ID field, back to back
+ *
+ * Records are fixed-width so the back-office can map the file and read
+ * ticket N at offset 64 + N * 64 without parsing anything. The layout
+ * evolves by bumping kVersion; only kVersion files are read.
+ *
+ * loadInto() fills a store straight from the mapping: record fields are
+ * copied as TicketRecords and IDs are read as views into the file, so no
+ * Ticket or ID string is built on the way (see TicketStore bulk loading).
+ */
+struct TicketSnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t recordCount;
+    uint64_t longIdBytes;
+    char reserved[32];
+};
+
+struct TicketSnapshotRecord {
+    int64_t creationTime;     // UTC seconds since the Unix epoch
+    int32_t validityDays;
+    int32_t lineNumber;
+    char ticketId[36];        // NUL-padded; empty when the ID is stored out of line
+    uint32_t longIdLength;    // Non-zero: the ID is in the long ID area,
+    uint64_t longIdOffset;    // at this offset from its start
+};
+
+static_assert(sizeof(TicketSnapshotHeader) == 64, "snapshot header must be 64 bytes");
+static_assert(sizeof(TicketSnapshotRecord) == 64, "snapshot record must be 64 bytes");
+
+class TicketSnapshot {
+public:
+    static constexpr uint32_t kVersion = 2;
+    static const char kMagic[8];
+
+    // Map an existing snapshot; throws std::runtime_error if it is invalid
+    explicit TicketSnapshot(const std::string& path);
+    ~TicketSnapshot();
+
+    TicketSnapshot(const TicketSnapshot&) = delete;
+    TicketSnapshot& operator=(const TicketSnapshot&) = delete;
+
+    size_t size() const { return count_; }
+    // Throws std::runtime_error if the record's long ID lies outside the file
+    Ticket ticket(size_t i) const;
+    // Fields of ticket i (record.id is left to the store) and its ID as a
+    // view into the mapping; false if its long ID lies outside the file
+    bool record(size_t i, TicketRecord& record, std::string_view& ticketId) const;
+
+    // Insert every ticket into the store: records are bucketed by shard on
+    // threadCount threads (0: one per core), then each shard is filled under
+    // a single lock. Returns the number inserted; IDs already in the store
+    // are skipped. Throws std::runtime_error for a record that cannot be read.
+    size_t loadInto(TicketStore& store, size_t threadCount = 0) const;
+
+    // True if the file starts with the snapshot magic
+    static bool isSnapshotFile(const std::string& path);
+
+    // True for paths that should be written as binary snapshots (*.bin)
+    static bool isSnapshotPath(const std::string& path);
+
+    static void write(const std::string& path, const std::vector<Ticket>& tickets);
+
+private:
+    void* mapping_;
+    size_t mappingSize_;
+    const char* records_;
+    size_t count_;
+    const char* longIds_;
+    size_t longIdBytes_;
+
+    bool idOf(const TicketSnapshotRecord& record, std::string_view& ticketId) const;
+};
+
+#endif // TICKET_SNAPSHOT_H
@@ -0,0 +1,156 @@
+// include/backoffice/ticket_store.h
+#ifndef TICKET_STORE_H
+#define TICKET_STORE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <shared_mutex>
+#include <mutex>
+#include <atomic>
+#include <cstddef>
+#include "ticket.h"
+#include "ticket_record.h"
+#include "ticket_csv.h"
+#include "ticket_index.h"
+
+/**
+ * @brief Lock-striped in-memory ticket store
+ *
+ * Tickets are spread over a power-of-two number of shards by the hash of
+ * their ID. Each shard owns its tickets, its own TicketIndex and a
+ * reader/writer lock, so:
+ * - a sale locks one shard exclusively for an append + index insert
+ * - validations take one shard's lock in shared mode and only wait for a
+ *   sale that hashes to the same shard
+ * - full-table reads (dump, snapshot) walk the shards one at a time in
+ *   shared mode and never stop the whole store
+ *
+ * A shard keeps its tickets as packed TicketRecords in one contiguous
+ * vector. IDs that are not Snowflake IDs go to the shard's side table, a
+ * single string holding their text back to back, and the record's legacy
+ * handle is (offset << 16 | length). Ticket objects are only built at the
+ * API boundary (find, snapshot, copyPage, forEach).
+ */
+class TicketStore {
+public:
+    static constexpr size_t kDefaultShardCount = 64;
+    // Longest non-Snowflake ID the side table accepts
+    static constexpr size_t kMaxLegacyIdLength = 0xFFFF;
+
+    // Position in the store's iteration order. Shards only ever grow, so a
+    // cursor stays valid while tickets are being added.
+    struct Cursor {
+        size_t shard = 0;
+        size_t offset = 0;
+    };
+
+    explicit TicketStore(size_t shardCount = kDefaultShardCount);
+
+    TicketStore(const TicketStore&) = delete;
+    TicketStore& operator=(const TicketStore&) = delete;
+
+    // Add a ticket; false if a ticket with the same ID already exists (or
+    // the ID is longer than kMaxLegacyIdLength)
+    bool insert(const Ticket& ticket);
+
+    // Add several tickets, locking each affected shard once. Returns the
+    // number inserted; tickets whose ID already exists are skipped.
+    size_t insertMany(const std::vector<Ticket>& tickets);
+
+    bool contains(std::string_view ticketId) const;
+    bool find(std::string_view ticketId, Ticket& ticket) const;
+    bool find(std::string_view ticketId, TicketRecord& record) const;
+    // Look up several IDs, read-locking each affected shard once; result[i]
+    // tells whether ticketIds[i] is in the store and, if so, its record is
+    // copied into records[i] (resized to match ticketIds)
+    std::vector<bool> findMany(const std::vector<std::string_view>& ticketIds,
+                               std::vector<TicketRecord>& records) const;
+
+    // Pre-size every shard for the expected total number of tickets
+    void reserve(size_t expectedTickets);
+
+    // Bulk loading: callers partition tickets with shardIndex() and fill
+    // distinct shards from different threads. Returns the number inserted;
+    // tickets whose ID already exists are skipped.
+    size_t shardIndex(std::string_view ticketId) const {
+        return (TicketIndex::hash(ticketId) >> 40) & shardMask_;
+    }
+    size_t insertIntoShard(size_t shard, const std::vector<TicketCsv::Row>& rows);
+    // Packed records (record.id is ignored), ids[i] being records[i]'s ID
+    size_t insertIntoShard(size_t shard, const std::vector<TicketRecord>& records,
+                           const std::vector<std::string_view>& ids);
+
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
+    size_t shardCount() const { return shards_.size(); }
+
+    // Copy of every ticket, taken one shard at a time
+    std::vector<Ticket> snapshot() const;
+
+    // Number of tickets in each shard; bounds a consistent paged read
+    std::vector<size_t> shardSizes() const;
+
+    // Append up to limit tickets from cursor onwards to out, stopping at the
+    // per-shard bounds, and advance the cursor. Each shard is read-locked
+    // only while its tickets are copied. Returns the number copied; the
+    // cursor's shard equals shardCount() once everything has been read.
+    size_t copyPage(Cursor& cursor, const std::vector<size_t>& bounds, size_t limit,
+                    std::vector<Ticket>& out) const;
+
+    // Visit every ticket; each shard stays read-locked while it is visited.
+    // The Ticket passed to fn is reused between calls.
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        Ticket ticket;
+        for (const auto& shard : shards_) {
+            std::shared_lock<std::shared_mutex> lock(shard->mutex);
+            for (const auto& record : shard->records) {
+                ticket.assign(record, shard->legacyId(record));
+                fn(static_cast<const Ticket&>(ticket));
+            }
+        }
+    }
+
+private:
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        std::vector<TicketRecord> records;
+        std::string legacyIds;  // Side table for non-Snowflake IDs
+        TicketIndex index;
+
+        // Text of a legacy ID; empty for Snowflake records
+        std::string_view legacyId(const TicketRecord& record) const {
+            if (!record.hasLegacyId()) return {};
+            uint64_t handle = record.legacyHandle();
+            return std::string_view(legacyIds).substr(handle >> 16, handle & kMaxLegacyIdLength);
+        }
+    };
+
+    // A ticket ID, hashed and packed once per lookup or insert
+    struct Key {
+        std::string_view text;
+        uint64_t hash;
+        uint64_t packed;  // TicketRecord::packId(text)
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    size_t shardMask_;
+    std::atomic<size_t> size_;
+
+    static Key keyOf(std::string_view ticketId) {
+        return Key{ticketId, TicketIndex::hash(ticketId), TicketRecord::packId(ticketId)};
+    }
+
+    // High hash bits pick the shard, the index probes with the low bits
+    Shard& shardFor(uint64_t idHash) const {
+        return *shards_[(idHash >> 40) & shardMask_];
+    }
+
+    static uint32_t findLocked(const Shard& shard, const Key& key);
+    // record.id is ignored and replaced by the packed ID
+    static bool insertLocked(Shard& shard, const Key& key, TicketRecord record);
+    static TicketRecord fieldsOf(const Ticket& ticket);
+};
+
+#endif // TICKET_STORE_H
@@ -0,0 +1,48 @@
+// include/backoffice/ticket_validator.h
+#ifndef TICKET_VALIDATOR_H
+#define TICKET_VALIDATOR_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "ticket.h"
+#include "ticket_record.h"
+#include "ticket_signer.h"
+#include "ticket_store.h"
+
+/**
+ * @brief Back-office verdict on a presented ticket
+ *
+ * The store is the source of truth: a ticket is valid only if its ID is
+ * stored, the presented creation time, validity and line match the stored
+ * record, and the stored record has not expired. A ticket altered on the
+ * way (e.g. with its validity raised) is refused even when its ID exists,
+ * so a ticket with its MAC stripped gains nothing. Unsigned tickets are
+ * accepted: those sold before a signing key was configured are still valid.
+ */
+class TicketValidator {
+public:
+    struct Verdict {
+        bool valid = false;
+        std::string message;
+    };
+
+    explicit TicketValidator(const TicketStore& store);
+
+    // signature as returned by TicketSigner::verify (not Malformed)
+    Verdict check(const Ticket& ticket, TicketSigner::Status signature) const;
+    Verdict check(const Ticket& ticket, TicketSigner::Status signature, int64_t now) const;
+
+    // Several tickets, read-locking each affected store shard once
+    std::vector<Verdict> checkMany(const std::vector<const Ticket*>& tickets,
+                                   const std::vector<TicketSigner::Status>& signatures) const;
+
+    // Verdict against the stored record (nullptr when the ID is unknown)
+    static Verdict verdict(const Ticket& ticket, TicketSigner::Status signature, const TicketRecord* stored,
+                           int64_t now);
+
+private:
+    const TicketStore& store_;
+};
+
+#endif // TICKET_VALIDATOR_H
@@ -0,0 +1,57 @@
+// include/common/base64.h
+#ifndef BASE64_H
+#define BASE64_H
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+/**
+ * @brief Base64 codec used for tickets on the wire
+ *
+ * Scalar code uses lookup tables built at compile time and writes into
+ * presized buffers. On x86-64 the bulk of the input goes through SSSE3 or
+ * AVX2 kernels, chosen once at startup from the CPU's capabilities; the
+ * scalar code finishes the tail and reports errors.
+ *
+ * Variants:
+ * - Standard: RFC 4648 alphabet ('+', '/'), padded with '='. Decoding
+ *   also accepts unpadded input.
+ * - Url: RFC 4648 URL-safe alphabet ('-', '_'), no padding. Decoding is
+ *   scalar only.
+ */
+class Base64 {
+public:
+    enum class Variant { Standard, Url };
+    enum class Isa { Scalar, SSSE3, AVX2 };
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    static constexpr size_t encodedSize(size_t size, Variant variant = Variant::Standard) {
+        return variant == Variant::Standard ? (size + 2) / 3 * 4 : size / 3 * 4 + (size % 3 ? size % 3 + 1 : 0);
+    }
+
+    // Upper bound of the decoded size (exact for unpadded input)
+    static constexpr size_t maxDecodedSize(size_t length) {
+        return length / 4 * 3 + (length % 4 > 1 ? length % 4 - 1 : 0);
+    }
+
+    // out must hold encodedSize(size) characters; returns the count written
+    static size_t encode(const void* data, size_t size, char* out, Variant variant = Variant::Standard);
+
+    // out must hold maxDecodedSize(length) bytes; returns the number of
+    // bytes written, or npos when the text is not valid Base64
+    static size_t decode(const char* text, size_t length, void* out, Variant variant = Variant::Standard);
+
+    static std::string encode(std::string_view data, Variant variant = Variant::Standard);
+    static bool decode(std::string_view text, std::string& out, Variant variant = Variant::Standard);
+
+    // Kernel set in use. setIsa() (for tests and benchmarks) falls back to
+    // the best supported set at or below the requested one.
+    static Isa isa();
+    static Isa setIsa(Isa isa);
+    static bool supported(Isa isa);
+    static const char* isaName(Isa isa);
+};
+
+#endif // BASE64_H
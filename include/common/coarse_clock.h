@@ -0,0 +1,68 @@
+// include/common/coarse_clock.h
+#ifndef COARSE_CLOCK_H
+#define COARSE_CLOCK_H
+
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Process-wide coarse wall clock
+ *
+ * Once start() has been called, one background thread stores the current
+ * UTC time (milliseconds since the Unix epoch) in an atomic about once per
+ * millisecond, so now() on the request path is a single relaxed load
+ * instead of a clock read. Before start() and after stop(), now() reads
+ * the system clock directly.
+ *
+ * formatNow() caches the ISO 8601 text of the current second per thread,
+ * so log lines and reports format a date at most once a second and never
+ * touch the non-thread-safe localtime().
+ *
+ * Code that decides on time (e.g. Ticket::isExpired) takes the clock as a
+ * template parameter: anything with an `int64_t now() const` returning
+ * epoch seconds. CoarseClock is the production clock, VirtualClock lets
+ * tests and simulations move time by hand.
+ */
+class CoarseClock {
+public:
+    static constexpr std::chrono::microseconds kDefaultInterval{1000};
+
+    // Start the refresh thread; no-op if it is already running
+    static void start(std::chrono::microseconds interval = kDefaultInterval);
+    static void stop();
+    static bool running();
+
+    static int64_t nowMs();
+    static int64_t now() { return nowMs() / 1000; }  // Seconds since the Unix epoch
+
+    // Current time as "YYYY-MM-DDTHH:MM:SS" (UTC); writes Iso8601::kLength
+    // characters, no terminator
+    static void formatNow(char* out);
+    static std::string formatNow();
+
+    static int64_t systemNowMs();
+};
+
+/**
+ * @brief Manually driven clock for tests and simulations
+ */
+class VirtualClock {
+public:
+    explicit VirtualClock(int64_t epochSeconds = 0) : nowMs_(epochSeconds * 1000) {}
+
+    int64_t now() const { return nowMs() / 1000; }
+    int64_t nowMs() const { return nowMs_.load(std::memory_order_relaxed); }
+
+    void set(int64_t epochSeconds) { nowMs_.store(epochSeconds * 1000, std::memory_order_relaxed); }
+    void advance(std::chrono::milliseconds step) {
+        nowMs_.fetch_add(step.count(), std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<int64_t> nowMs_;
+};
+
+#endif // COARSE_CLOCK_H
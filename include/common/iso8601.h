@@ -0,0 +1,45 @@
+// include/common/iso8601.h
+#ifndef ISO8601_H
+#define ISO8601_H
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief UTC timestamps <-> "YYYY-MM-DDTHH:MM:SS"
+ *
+ * Locale- and time-zone-independent replacement for get_time/mktime and
+ * localtime/put_time. Dates are converted with Howard Hinnant's
+ * days_from_civil / civil_from_days algorithms, so nothing allocates
+ * except the std::string overload of format().
+ *
+ * Only used where tickets cross a text boundary (JSON, CSV); tickets
+ * themselves carry seconds since the Unix epoch.
+ */
+class Iso8601 {
+public:
+    static constexpr size_t kLength = 19;
+
+    // Accepts "YYYY-MM-DDTHH:MM:SS" with an optional trailing 'Z'.
+    // False for anything else, including out-of-range fields.
+    static bool parse(std::string_view text, int64_t& epochSeconds);
+
+    // Writes exactly kLength characters (no terminator)
+    static void format(int64_t epochSeconds, char* out);
+    static std::string format(int64_t epochSeconds);
+
+    static constexpr int64_t daysFromCivil(int64_t year, unsigned month, unsigned day) {
+        year -= month <= 2;
+        const int64_t era = (year >= 0 ? year : year - 399) / 400;
+        const unsigned yoe = static_cast<unsigned>(year - era * 400);
+        const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + static_cast<int64_t>(doe) - 719468;
+    }
+
+    static void civilFromDays(int64_t days, int64_t& year, unsigned& month, unsigned& day);
+};
+
+#endif // ISO8601_H
@@ -0,0 +1,82 @@
+// include/common/payload_codec.h
+#ifndef PAYLOAD_CODEC_H
+#define PAYLOAD_CODEC_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+
+enum class PayloadFormat : uint8_t {
+    Json,
+    Cbor,         // RFC 8949
+    MessagePack
+};
+
+/**
+ * @brief Serialization of REST bodies and MQTT payloads
+ *
+ * Messages are built as nlohmann::json values and written in one of three
+ * encodings; CBOR and MessagePack are smaller than text JSON and parse
+ * without number or string scanning, which matters on constrained gate
+ * links. The back-office picks the format of a request from Content-Type
+ * and the format of its response from Accept (see negotiate()); MQTT
+ * clients configure a format per topic (see TopicFormats).
+ */
+class PayloadCodec {
+public:
+    using json = nlohmann::json;
+
+    // Throws nlohmann::json::parse_error for a malformed payload
+    static json parse(std::string_view payload, PayloadFormat format);
+    static std::string dump(const json& value, PayloadFormat format);
+
+    // "application/json", "application/cbor", "application/msgpack"
+    static const char* contentType(PayloadFormat format);
+    // Media type of a Content-Type header, parameters ignored; also accepts
+    // "application/x-msgpack" and "application/vnd.msgpack"
+    static bool fromContentType(std::string_view contentType, PayloadFormat& format);
+
+    // Best supported type of an Accept header by q-value (ties go to the
+    // first listed); fallback for an empty header, "*/*" or no match
+    static PayloadFormat negotiate(std::string_view accept, PayloadFormat fallback);
+
+    // "json", "cbor", "msgpack"
+    static const char* name(PayloadFormat format);
+    static bool fromName(std::string_view name, PayloadFormat& format);
+    // Format named by an environment variable, JSON when unset; throws
+    // std::invalid_argument for an unknown name
+    static PayloadFormat fromEnvironment(const char* variable);
+};
+
+/**
+ * @brief Payload format per MQTT topic
+ *
+ * Parsed from "<topic filter>=<format>,..." (e.g. MQTT_PAYLOAD_FORMATS=
+ * "ticket/validation/#=cbor,ticket/validation/response=json"). A filter is
+ * an exact topic or a prefix ending in "/#"; the most specific match wins
+ * and unlisted topics use JSON.
+ */
+class TopicFormats {
+public:
+    TopicFormats() = default;
+
+    void set(std::string filter, PayloadFormat format);
+    PayloadFormat forTopic(std::string_view topic) const;
+    bool empty() const { return filters_.empty(); }
+
+    // "topic=format" pairs for logging
+    std::string describe() const;
+
+    // Throws std::invalid_argument for a malformed entry or unknown format
+    static TopicFormats parse(std::string_view spec);
+    // MQTT_PAYLOAD_FORMATS; no entries when unset
+    static TopicFormats fromEnvironment();
+
+private:
+    std::vector<std::pair<std::string, PayloadFormat>> filters_;
+};
+
+#endif // PAYLOAD_CODEC_H
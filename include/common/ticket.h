@@ -3,8 +3,13 @@
 #define TICKET_H
 
 #include <string>
+#include <string_view>
 #include <chrono>
+#include <cstdint>
+#include <cstddef>
 #include <nlohmann/json.hpp>
+#include "ticket_record.h"
+#include "coarse_clock.h"
 
 using json = nlohmann::json;
 
@@ -13,57 +18,116 @@ using json = nlohmann::json;
  * 
  * As per requirements, ticket contains:
  * - Ticket ID (generated by the Back-Office)
- * - Creation Date
+ * - Creation Date (kept as UTC epoch seconds, ISO 8601 in JSON/CSV)
  * - Validity in Days
  * - Line Number (Geographical validity)
  */
 class Ticket {
 public:
+    static constexpr int64_t kSecondsPerDay = TicketRecord::kSecondsPerDay;
+
     // Constructors
     Ticket();
     Ticket(const std::string& id, int validityDays, int lineNumber);
+    // Throws std::invalid_argument if creationDate is not "YYYY-MM-DDTHH:MM:SS"
+    Ticket(const std::string& id, const std::string& creationDate, int validityDays, int lineNumber);
+    Ticket(const std::string& id, int64_t creationTime, int validityDays, int lineNumber);
     
     // Getters
-    std::string getId() const { return ticketId_; }
-    std::string getCreationDate() const { return creationDate_; }
+    const std::string& getId() const { return ticketId_; }
+    std::string getCreationDate() const;                      // ISO 8601, UTC
+    int64_t getCreationTime() const { return creationTime_; } // Seconds since the Unix epoch
+    int64_t getExpiryTime() const { return creationTime_ + validityDays_ * kSecondsPerDay; }
     int getValidityDays() const { return validityDays_; }
     int getLineNumber() const { return lineNumber_; }
     
     // Setters
     void setId(const std::string& id) { ticketId_ = id; }
-    void setCreationDate(const std::string& date) { creationDate_ = date; }
+    void setCreationDate(const std::string& date);  // Throws std::invalid_argument
+    void setCreationTime(int64_t creationTime) { creationTime_ = creationTime; }
     void setValidityDays(int days) { validityDays_ = days; }
     void setLineNumber(int line) { lineNumber_ = line; }
     
-    // Validation methods
+    // Validation methods (against CoarseClock)
     bool isValid() const;
     bool isExpired() const;
+    // Against any clock with an epoch-seconds now(), e.g. a VirtualClock
+    template <typename Clock>
+    bool isValid(const Clock& clock) const { return hasValidFields() && !isExpired(clock); }
+    template <typename Clock>
+    bool isExpired(const Clock& clock) const { return isExpiredAt(clock.now()); }
+    // A ticket expires validityDays after its creation, to the second
+    bool isExpiredAt(int64_t now) const { return now >= getExpiryTime(); }
+    
+    // Packed form for storage. An ID that is not a canonical Snowflake ID
+    // packs as TicketRecord::kLegacyId; the caller keeps its text and adds
+    // the handle.
+    TicketRecord toRecord() const;
+    // legacyId is the ID text when record.hasLegacyId()
+    static Ticket fromRecord(const TicketRecord& record, std::string_view legacyId = {});
+    // Same, reusing this ticket's ID buffer
+    void assign(const TicketRecord& record, std::string_view legacyId = {});
     
     // Serialization to/from JSON
     std::string toJson() const;
     static Ticket fromJson(const std::string& jsonStr);
     
-    // Base64 serialization (as required by task)
+    // Base64 serialization (as required by task).
+    // Tickets with a Snowflake ID (see TicketIdAllocator) are encoded in the
+    // compact binary wire format, others as JSON; fromBase64 accepts both.
     std::string toBase64() const;
     static Ticket fromBase64(const std::string& base64Str);
+    // Appends toBase64() to out; scratch holds the JSON payload of legacy
+    // tickets and is reused between calls (see TicketCodec)
+    void appendBase64(std::string& out, std::string& scratch) const;
+
+    // Decode without exceptions or temporary strings: Base64 goes into a
+    // stack buffer and the payload is scanned straight into ticket (JSON
+    // without building a DOM). Reusing the same Ticket avoids allocating
+    // even for IDs too long for the small-string buffer.
+    // False if the text is not a valid ticket; ticket is then unspecified.
+    static bool tryFromBase64(std::string_view base64Str, Ticket& ticket);
+    // Largest decoded payload tryFromBase64 accepts (JSON tickets are ~110 bytes)
+    static constexpr size_t kMaxPayloadSize = 512;
+    // Same for an already decoded payload (binary or JSON)
+    static bool tryFromPayload(const char* data, size_t size, Ticket& ticket);
+
+    // Binary wire format, 24 bytes little-endian:
+    //   u8 version | u8 flags | u16 validityDays | u32 lineNumber |
+    //   u64 ticket ID | i64 creation time (seconds since the Unix epoch)
+    // Signed tickets (see TicketSigner) set kWireFlagSigned, carry the key
+    // ID in the high nibble of flags and append a kWireSignatureSize MAC.
+    static constexpr uint8_t kWireVersion = 1;
+    static constexpr size_t kWireSize = 24;
+    static constexpr uint8_t kWireFlagSigned = 0x01;
+    static constexpr int kWireKeyIdShift = 4;
+    static constexpr size_t kWireSignatureSize = 12;
+
+    // False when the ticket's fields do not fit the binary format
+    bool toBinary(std::string& out) const;
+    bool toBinary(char* out) const;  // kWireSize bytes
+    static Ticket fromBinary(const std::string& data);
+    // Non-throwing form; a signed payload is accepted without checking its MAC
+    static bool tryFromBinary(const char* data, size_t size, Ticket& ticket);
     
     // For nlohmann::json automatic conversion
     friend void to_json(json& j, const Ticket& t);
     friend void from_json(const json& j, Ticket& t);
 
+    static int64_t currentTime() { return CoarseClock::now(); }
+
 private:
+    bool hasValidFields() const { return !ticketId_.empty() && validityDays_ > 0; }
+
     std::string ticketId_;
-    std::string creationDate_;  // ISO 8601 format: YYYY-MM-DDTHH:MM:SS
+    int64_t creationTime_;  // UTC, seconds since the Unix epoch
     int validityDays_;
     int lineNumber_;
     
-    // Helper functions
-    std::chrono::system_clock::time_point getCreationTimePoint() const;
-    static std::string getCurrentDateISO();
+    static int64_t parseCreationDate(const std::string& date);
+    static bool scanJson(std::string_view text, Ticket& ticket);
     
-    // Base64 encoding/decoding helpers
-    static std::string base64Encode(const std::string& input);
-    static std::string base64Decode(const std::string& input);
+    void appendJsonPayload(std::string& out) const;
 };
 
 #endif // TICKET_H
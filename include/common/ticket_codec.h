@@ -0,0 +1,68 @@
+// include/common/ticket_codec.h
+#ifndef TICKET_CODEC_H
+#define TICKET_CODEC_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <iterator>
+#include <cstdint>
+#include <cstddef>
+#include "ticket.h"
+
+class TicketSigner;
+
+/**
+ * @brief Bulk Base64 encoding and decoding of tickets
+ *
+ * For imports and batch endpoints handling thousands of tickets at once:
+ * - encodeMany appends every ticket to one caller-provided string and
+ *   records where each one ends, instead of returning a string per ticket
+ * - decodeMany fills caller-provided tickets (reusing their ID buffers)
+ *   and reports a status per item instead of throwing
+ *
+ * The wire format is the one of Ticket::toBase64 / Ticket::tryFromBase64.
+ * Ranges are anything with std::data/std::size (vectors, arrays); the
+ * pointer overloads take a base pointer and a count.
+ */
+class TicketCodec {
+public:
+    enum class Status : uint8_t {
+        Ok,
+        TooLong,         // Longer than any ticket payload
+        InvalidBase64,
+        InvalidPayload   // Valid Base64, but not a ticket
+    };
+
+    // Append the Base64 form of each ticket to out; ticket i spans
+    // [ends[i - 1], ends[i]) (from out's original size for i = 0).
+    // With a signer that can sign, binary tickets are signed.
+    static void encodeMany(const Ticket* tickets, size_t count, std::string& out, size_t* ends,
+                           const TicketSigner* signer = nullptr);
+
+    template <typename Tickets>
+    static void encodeMany(const Tickets& tickets, std::string& out, std::vector<size_t>& ends,
+                           const TicketSigner* signer = nullptr) {
+        ends.resize(std::size(tickets));
+        encodeMany(std::data(tickets), std::size(tickets), out, ends.data(), signer);
+    }
+
+    // Decode texts[i] into tickets[i] and statuses[i]; returns the number
+    // decoded. Signatures are not checked (see TicketSigner::verify).
+    static size_t decodeMany(const std::string_view* texts, size_t count, Ticket* tickets, Status* statuses);
+    static size_t decodeMany(const std::string* texts, size_t count, Ticket* tickets, Status* statuses);
+
+    // tickets and statuses are resized to match texts
+    template <typename Texts>
+    static size_t decodeMany(const Texts& texts, std::vector<Ticket>& tickets, std::vector<Status>& statuses) {
+        tickets.resize(std::size(texts));
+        statuses.resize(std::size(texts));
+        return decodeMany(std::data(texts), std::size(texts), tickets.data(), statuses.data());
+    }
+
+    static Status decode(std::string_view text, Ticket& ticket);
+
+    static const char* statusName(Status status);
+};
+
+#endif // TICKET_CODEC_H
@@ -0,0 +1,90 @@
+// include/common/ticket_id.h
+#ifndef TICKET_ID_H
+#define TICKET_ID_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Snowflake-style ticket ID allocator
+ *
+ * A ticket ID is a 64-bit integer:
+ *   [ 41 bits ms since 2024-01-01 UTC | 10 bits node | 12 bits sequence ]
+ * rendered as a 13-character Crockford base32 string (e.g. "00BXJ7Q2R0G01").
+ *
+ * IDs from one allocator are strictly increasing; allocators with different
+ * node IDs never collide, so several back-office instances can sell tickets
+ * without coordination and without scanning existing IDs at startup.
+ *
+ * The timestamp and sequence are packed in one atomic word and advanced
+ * with a CAS loop. When more than 4096 IDs are requested within one
+ * millisecond (or the wall clock steps back) the sequence simply carries
+ * into the timestamp, borrowing IDs from the next milliseconds instead of
+ * blocking.
+ */
+class TicketIdAllocator {
+public:
+    static constexpr int kTimestampBits = 41;
+    static constexpr int kNodeBits = 10;
+    static constexpr int kSequenceBits = 12;
+    static constexpr uint32_t kMaxNodeId = (1u << kNodeBits) - 1;
+    static constexpr int64_t kEpochMs = 1704067200000;  // 2024-01-01T00:00:00Z
+    static constexpr size_t kEncodedLength = 13;
+
+    // Milliseconds since the Unix epoch
+    using Clock = int64_t (*)();
+
+    // Throws std::invalid_argument if nodeId exceeds kMaxNodeId
+    explicit TicketIdAllocator(uint32_t nodeId = 0, Clock clock = systemClock);
+
+    TicketIdAllocator(const TicketIdAllocator&) = delete;
+    TicketIdAllocator& operator=(const TicketIdAllocator&) = delete;
+
+    uint64_t next();
+
+    // Reserve count consecutive IDs with a single CAS
+    std::vector<uint64_t> allocateBlock(size_t count);
+
+    std::string nextString() { return encode(next()); }
+
+    uint32_t nodeId() const { return nodeId_; }
+
+    // Node ID from BACKOFFICE_NODE_ID (0 when unset).
+    // Throws std::invalid_argument when the value is not a valid node ID.
+    static uint32_t nodeIdFromEnvironment();
+
+    // Crockford base32, fixed width, upper case
+    static std::string encode(uint64_t id);
+    // Writes kEncodedLength characters to out, no terminator
+    static void encode(uint64_t id, char* out);
+    // Case-insensitive; accepts the Crockford aliases O->0 and I/L->1
+    static bool decode(std::string_view text, uint64_t& id);
+    // Only the exact spelling encode() produces, so the text round-trips
+    static bool decodeCanonical(std::string_view text, uint64_t& id);
+
+    static int64_t timestampMs(uint64_t id) {
+        return static_cast<int64_t>(id >> (kNodeBits + kSequenceBits)) + kEpochMs;
+    }
+    static uint32_t nodeOf(uint64_t id) {
+        return static_cast<uint32_t>(id >> kSequenceBits) & kMaxNodeId;
+    }
+    static uint32_t sequenceOf(uint64_t id) {
+        return static_cast<uint32_t>(id) & ((1u << kSequenceBits) - 1);
+    }
+
+    static int64_t systemClock();
+
+private:
+    uint32_t nodeId_;
+    Clock clock_;
+    std::atomic<uint64_t> state_;  // (ms since kEpochMs << kSequenceBits) | sequence
+
+    uint64_t reserve(uint64_t count);
+    uint64_t compose(uint64_t state) const;
+};
+
+#endif // TICKET_ID_H
@@ -0,0 +1,49 @@
+// include/common/ticket_record.h
+#ifndef TICKET_RECORD_H
+#define TICKET_RECORD_H
+
+#include <string_view>
+#include <cstdint>
+#include <type_traits>
+#include "ticket_id.h"
+
+/**
+ * @brief Packed, trivially copyable ticket for bulk in-memory storage
+ *
+ * 24 bytes and no heap storage, so millions of tickets sit contiguously in
+ * one vector. Ticket converts to and from this form for the API layer.
+ *
+ * The ID is the 64-bit Snowflake value (see TicketIdAllocator), which never
+ * has the top bit set. Tickets with any other ID (legacy "TKT-..." IDs,
+ * non-canonical spellings) are packed as kLegacyId plus a handle: the owner
+ * of the records keeps the ID text in a side table and picks the handle.
+ */
+struct TicketRecord {
+    static constexpr uint64_t kLegacyId = 1ULL << 63;
+    static constexpr int64_t kSecondsPerDay = 86400;
+
+    uint64_t id = 0;
+    int64_t creationTime = 0;  // UTC, seconds since the Unix epoch
+    int32_t validityDays = 0;
+    int32_t lineNumber = 0;
+
+    // Snowflake value of a ticket ID, or kLegacyId when the text is not one
+    static uint64_t packId(std::string_view ticketId) {
+        uint64_t value = 0;
+        if (TicketIdAllocator::decodeCanonical(ticketId, value) && (value & kLegacyId) == 0) {
+            return value;
+        }
+        return kLegacyId;
+    }
+
+    bool hasLegacyId() const { return (id & kLegacyId) != 0; }
+    uint64_t legacyHandle() const { return id & ~kLegacyId; }
+
+    int64_t expiryTime() const { return creationTime + validityDays * kSecondsPerDay; }
+    bool isExpiredAt(int64_t now) const { return now >= expiryTime(); }
+};
+
+static_assert(std::is_trivially_copyable_v<TicketRecord>, "TicketRecord must stay a POD");
+static_assert(sizeof(TicketRecord) == 24, "TicketRecord layout changed");
+
+#endif // TICKET_RECORD_H
@@ -0,0 +1,79 @@
+// include/common/ticket_signer.h
+#ifndef TICKET_SIGNER_H
+#define TICKET_SIGNER_H
+
+#include <string>
+#include <string_view>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include "ticket.h"
+
+/**
+ * @brief HMAC signatures for binary tickets
+ *
+ * A signed ticket is the 24-byte binary payload (see Ticket) with
+ * kWireFlagSigned and the key ID set in its flags byte, followed by the
+ * first 12 bytes of HMAC-SHA256 over those 24 bytes: 36 bytes, 48 Base64
+ * characters. Gates holding the same keyring can then trust a ticket's
+ * fields without asking the back-office.
+ *
+ * Up to 16 keys (IDs 0-15) can be loaded at once so keys can be rotated:
+ * new tickets are signed with the active key while tickets signed with an
+ * older key still verify until that key is removed. Only tickets with a
+ * binary form (Snowflake IDs) can be signed.
+ */
+class TicketSigner {
+public:
+    static constexpr size_t kSignatureSize = Ticket::kWireSignatureSize;
+    static constexpr uint8_t kMaxKeyId = 15;
+    static constexpr size_t kMinKeySize = 16;
+
+    enum class Status {
+        Valid,         // Signed with a known key, MAC matches
+        Unsigned,      // Decodes, but carries no signature
+        UnknownKey,    // Signed with a key this signer does not have
+        BadSignature,  // MAC mismatch: forged or altered
+        Malformed      // Not a ticket at all
+    };
+
+    // Without keys, sign() fails and signed tickets verify as UnknownKey
+    TicketSigner() = default;
+
+    // Throws std::invalid_argument for an ID above kMaxKeyId or a secret
+    // shorter than kMinKeySize bytes
+    void addKey(uint8_t keyId, std::string secret);
+    // Key used by sign(); throws std::invalid_argument if it was not added
+    void setActiveKey(uint8_t keyId);
+
+    bool hasKeys() const;
+    bool canSign() const { return activeKey_ >= 0; }
+    int activeKey() const { return activeKey_; }
+
+    // Base64 of the signed ticket; false without an active key or when the
+    // ticket has no binary form
+    bool sign(const Ticket& ticket, std::string& base64) const;
+    // Same, appended to out without temporary strings
+    bool appendSigned(const Ticket& ticket, std::string& out) const;
+
+    // Decode a Base64 ticket and check its signature. ticket is filled for
+    // every status except Malformed. Does not allocate for binary tickets.
+    Status verify(std::string_view base64, Ticket& ticket) const;
+
+    // Keys from TICKET_SIGNING_KEYS ("<id>:<hex secret>,..."), active key
+    // from TICKET_SIGNING_KEY_ID (default: the last key listed). Returns a
+    // signer without keys when TICKET_SIGNING_KEYS is unset.
+    // Throws std::invalid_argument for malformed values.
+    static TicketSigner fromEnvironment();
+    static TicketSigner parse(std::string_view keys, std::string_view activeKeyId = {});
+
+    static const char* statusName(Status status);
+
+private:
+    std::array<std::string, kMaxKeyId + 1> keys_;
+    int activeKey_ = -1;
+
+    void computeMac(uint8_t keyId, const char* data, size_t size, unsigned char* mac) const;
+};
+
+#endif // TICKET_SIGNER_H
@@ -0,0 +1,59 @@
+// include/gate/backoffice_client.h
+#ifndef BACKOFFICE_CLIENT_H
+#define BACKOFFICE_CLIENT_H
+
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <httplib.h>
+#include "connection_pool.h"
+
+/**
+ * @brief Keep-alive HTTP client for the gate's calls to the Back-Office
+ *
+ * Requests go over pooled keep-alive connections instead of a new TCP
+ * connection per tap. An idle connection the server has closed in the
+ * meantime fails on first use before anything is sent; that request is
+ * retried once on another connection. Any other failure (e.g. a read timeout
+ * from a slow Back-Office) is returned as is and only drops its own
+ * connection, so the request may have reached the server.
+ */
+class BackOfficeClient {
+public:
+    using Pool = ConnectionPool<httplib::Client>;
+
+    struct Config {
+        std::chrono::seconds connectTimeout{2};
+        std::chrono::seconds readTimeout{5};
+        Pool::Config pool;
+    };
+
+    struct Stats {
+        Pool::Stats connections;
+        uint64_t requests = 0;
+        uint64_t reconnects = 0;  // Retried after a stale pooled connection
+    };
+
+    explicit BackOfficeClient(const std::string& url);
+    BackOfficeClient(const std::string& url, Config config);
+
+    // POST over a pooled connection, retried only when it cannot have
+    // reached the server (connect or write error on a reused connection)
+    httplib::Result post(const std::string& path, const httplib::Headers& headers,
+                         const std::string& body, const std::string& contentType);
+
+    Stats stats() const;
+    const std::string& url() const { return url_; }
+
+private:
+    std::string url_;
+    Config config_;
+    Pool pool_;
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> reconnects_{0};
+
+    std::unique_ptr<httplib::Client> connect() const;
+};
+
+#endif // BACKOFFICE_CLIENT_H
@@ -0,0 +1,159 @@
+// include/gate/connection_pool.h
+#ifndef CONNECTION_POOL_H
+#define CONNECTION_POOL_H
+
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <functional>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Pool of long-lived connections to one server
+ *
+ * acquire() hands out an idle connection when there is one and creates a
+ * new one otherwise; the returned Lease puts it back when it goes out of
+ * scope, unless the caller marked it broken. Idle connections are dropped
+ * after idleTimeout and at most maxIdle connections are kept. A connection
+ * the server closed while idle is not detected here; its user marks it
+ * broken when a request on it fails.
+ *
+ * Connection is any type, created by the factory. Thread-safe.
+ */
+template <typename Connection>
+class ConnectionPool {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Factory = std::function<std::unique_ptr<Connection>()>;
+
+    struct Config {
+        size_t maxIdle = 8;
+        std::chrono::milliseconds idleTimeout{30000};
+    };
+
+    struct Stats {
+        uint64_t acquired = 0;
+        uint64_t reused = 0;     // Served from the idle list
+        uint64_t created = 0;
+        uint64_t discarded = 0;  // Broken, expired or beyond maxIdle
+
+        double reuseRate() const {
+            return acquired == 0 ? 0.0 : static_cast<double>(reused) / static_cast<double>(acquired);
+        }
+    };
+
+    class Lease {
+    public:
+        Lease() = default;
+        Lease(Lease&& other) noexcept { *this = std::move(other); }
+        Lease& operator=(Lease&& other) noexcept {
+            if (this != &other) {
+                release();
+                pool_ = std::exchange(other.pool_, nullptr);
+                connection_ = std::move(other.connection_);
+                reused_ = other.reused_;
+                broken_ = other.broken_;
+            }
+            return *this;
+        }
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease() { release(); }
+
+        Connection& operator*() const { return *connection_; }
+        Connection* operator->() const { return connection_.get(); }
+        explicit operator bool() const { return connection_ != nullptr; }
+
+        // True when the connection had been used before (it may have gone
+        // stale since, e.g. closed by the server)
+        bool reused() const { return reused_; }
+        // Do not return the connection to the pool
+        void markBroken() { broken_ = true; }
+
+    private:
+        friend class ConnectionPool;
+
+        Lease(ConnectionPool* pool, std::unique_ptr<Connection> connection, bool reused)
+            : pool_(pool), connection_(std::move(connection)), reused_(reused) {}
+
+        void release() {
+            if (pool_ && connection_) {
+                pool_->giveBack(std::move(connection_), broken_);
+            }
+            pool_ = nullptr;
+            connection_.reset();
+        }
+
+        ConnectionPool* pool_ = nullptr;
+        std::unique_ptr<Connection> connection_;
+        bool reused_ = false;
+        bool broken_ = false;
+    };
+
+    explicit ConnectionPool(Factory factory, Config config = Config())
+        : factory_(std::move(factory)), config_(config) {}
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    // The most recently returned idle connection, otherwise a new one
+    Lease acquire() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stats_.acquired++;
+
+        while (!idle_.empty()) {
+            Idle entry = std::move(idle_.back());
+            idle_.pop_back();
+
+            if (Clock::now() - entry.since >= config_.idleTimeout) {
+                stats_.discarded++;
+                continue;
+            }
+            stats_.reused++;
+            return Lease(this, std::move(entry.connection), true);
+        }
+
+        stats_.created++;
+        lock.unlock();
+        return Lease(this, factory_(), false);
+    }
+
+    Stats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    size_t idleCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return idle_.size();
+    }
+
+private:
+    struct Idle {
+        std::unique_ptr<Connection> connection;
+        Clock::time_point since;
+    };
+
+    Factory factory_;
+    Config config_;
+
+    mutable std::mutex mutex_;
+    std::vector<Idle> idle_;  // Most recently returned last
+    Stats stats_;
+
+    void giveBack(std::unique_ptr<Connection> connection, bool broken) {
+        std::unique_ptr<Connection> dropped;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (broken || idle_.size() >= config_.maxIdle) {
+            stats_.discarded++;
+            dropped = std::move(connection);  // Closed after the lock is released
+            return;
+        }
+        idle_.push_back({std::move(connection), Clock::now()});
+    }
+};
+
+#endif // CONNECTION_POOL_H
@@ -0,0 +1,66 @@
+// include/gate/mpsc_queue.h
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <utility>
+
+/**
+ * @brief Unbounded lock-free multi-producer, single-consumer queue
+ *
+ * Dmitry Vyukov's node-based MPSC queue: push() is one atomic exchange
+ * plus one store (wait-free, any thread), tryPop() is only called from the
+ * consumer thread. The consumer may briefly see the queue as empty while a
+ * push is halfway done; the element shows up on a later tryPop().
+ *
+ * Each element costs one node allocation. T must be default-constructible
+ * and movable.
+ */
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue() : head_(&stub_), tail_(&stub_) {}
+
+    ~MpscQueue() {
+        T discarded;
+        while (tryPop(discarded)) {}
+        if (tail_ != &stub_) delete tail_;
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    void push(T value) {
+        Node* node = new Node(std::move(value));
+        Node* previous = head_.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    // Consumer thread only
+    bool tryPop(T& value) {
+        Node* tail = tail_;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next) return false;
+
+        // next becomes the new stub; its value is moved out
+        value = std::move(next->value);
+        tail_ = next;
+        if (tail != &stub_) delete tail;
+        return true;
+    }
+
+private:
+    struct Node {
+        Node() = default;
+        explicit Node(T v) : value(std::move(v)) {}
+
+        std::atomic<Node*> next{nullptr};
+        T value;
+    };
+
+    Node stub_;
+    alignas(64) std::atomic<Node*> head_;  // Producers
+    alignas(64) Node* tail_;               // Consumer
+};
+
+#endif // MPSC_QUEUE_H
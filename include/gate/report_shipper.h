@@ -0,0 +1,99 @@
+// include/gate/report_shipper.h
+#ifndef REPORT_SHIPPER_H
+#define REPORT_SHIPPER_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include "mpsc_queue.h"
+#include "validation_record.h"
+
+/**
+ * @brief Ships the gate's validation records to the Back-Office in the
+ * background
+ *
+ * add() only pushes the record onto a lock-free queue, so the tap path
+ * never waits for a report. A reporter thread collects the records and
+ * sends a report as soon as batchSize records are waiting or
+ * flushInterval has passed with at least one, whichever comes first.
+ *
+ * A failed report is retried with exponential backoff (retryDelay doubling
+ * up to maxRetryDelay); records arriving meanwhile join the next attempt.
+ * At most maxBuffered records are held, the oldest are dropped beyond.
+ * stop() makes one last attempt to ship what is left.
+ */
+class ReportShipper {
+public:
+    // Report body for a batch of records; called on the reporter thread
+    using Build = std::function<std::string(const std::vector<ValidationRecord>& records)>;
+    // Deliver a report; false to retry later
+    using Send = std::function<bool(const std::string& report)>;
+
+    struct Config {
+        size_t batchSize = 10;
+        std::chrono::milliseconds flushInterval{60000};
+        std::chrono::milliseconds retryDelay{500};
+        std::chrono::milliseconds maxRetryDelay{30000};
+        size_t maxBuffered = 10000;
+    };
+
+    struct Stats {
+        uint64_t reports = 0;   // Delivered
+        uint64_t shipped = 0;   // Records delivered
+        uint64_t failures = 0;  // Failed attempts
+        uint64_t dropped = 0;   // Records dropped over maxBuffered
+    };
+
+    ReportShipper(Build build, Send send);
+    ReportShipper(Build build, Send send, Config config);
+    ~ReportShipper();
+
+    ReportShipper(const ReportShipper&) = delete;
+    ReportShipper& operator=(const ReportShipper&) = delete;
+
+    // Any thread; lock-free
+    void add(ValidationRecord record);
+
+    // Ship what is left (one attempt) and join the reporter thread
+    void stop();
+
+    Stats stats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Upper bound on how long a lost wakeup can delay a full batch
+    static constexpr std::chrono::milliseconds kPollInterval{100};
+
+    Build build_;
+    Send send_;
+    Config config_;
+
+    MpscQueue<ValidationRecord> queue_;
+    std::atomic<size_t> queued_{0};
+
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    bool stopping_ = false;
+
+    std::atomic<uint64_t> reports_{0};
+    std::atomic<uint64_t> shipped_{0};
+    std::atomic<uint64_t> failures_{0};
+    std::atomic<uint64_t> dropped_{0};
+
+    std::thread thread_;  // Last: started once everything else is set up
+
+    void run();
+    void collect(std::deque<ValidationRecord>& pending);
+    bool ship(const std::deque<ValidationRecord>& pending);
+};
+
+#endif // REPORT_SHIPPER_H
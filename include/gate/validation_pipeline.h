@@ -0,0 +1,81 @@
+// include/gate/validation_pipeline.h
+#ifndef VALIDATION_PIPELINE_H
+#define VALIDATION_PIPELINE_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <functional>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Bounded worker pool for the gate's validations
+ *
+ * Each worker owns a FIFO queue; a task goes to the worker selected by its
+ * key (the ticket ID hash), so validations of the same ticket run, and
+ * publish their responses, in arrival order while other tickets proceed
+ * in parallel. The number of workers bounds the validations in flight.
+ *
+ * Queues hold at most queueCapacity tasks: submit() blocks while the
+ * target queue is full, which stops the MQTT consumer and leaves further
+ * requests with the broker instead of buffering them without limit.
+ */
+class ValidationPipeline {
+public:
+    using Task = std::function<void()>;
+
+    struct Config {
+        size_t workers = 4;
+        size_t queueCapacity = 32;  // Per worker
+    };
+
+    struct Stats {
+        uint64_t submitted = 0;
+        uint64_t completed = 0;
+        uint64_t stalls = 0;  // submit() calls that waited for queue space
+        size_t queued = 0;    // Waiting or running
+    };
+
+    ValidationPipeline();
+    explicit ValidationPipeline(Config config);
+    ~ValidationPipeline();
+
+    ValidationPipeline(const ValidationPipeline&) = delete;
+    ValidationPipeline& operator=(const ValidationPipeline&) = delete;
+
+    // Queue task on the worker owning key; false once stopped. An
+    // exception thrown by a task is logged and does not stop its worker.
+    bool submit(uint64_t key, Task task);
+
+    // Run the tasks already queued, then join the workers
+    void stop();
+
+    size_t workerCount() const { return lanes_.size(); }
+    size_t queueCapacity() const { return config_.queueCapacity; }
+    Stats stats() const;
+
+private:
+    struct Lane {
+        std::mutex mutex;
+        std::condition_variable notEmpty;
+        std::condition_variable notFull;
+        std::deque<Task> tasks;
+        bool stopping = false;
+        std::thread thread;
+    };
+
+    Config config_;
+    std::vector<std::unique_ptr<Lane>> lanes_;
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> completed_{0};
+    std::atomic<uint64_t> stalls_{0};
+
+    void run(Lane& lane);
+};
+
+#endif // VALIDATION_PIPELINE_H
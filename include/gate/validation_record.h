@@ -0,0 +1,37 @@
+// include/gate/validation_record.h
+#ifndef VALIDATION_RECORD_H
+#define VALIDATION_RECORD_H
+
+#include <string_view>
+#include <algorithm>
+#include <cstddef>
+#include "iso8601.h"
+
+/**
+ * @brief One tap, as shipped in reports
+ *
+ * Plain data with inline, NUL-terminated fields, so queueing a tap for the
+ * report allocates nothing beyond its queue node. Ticket IDs longer than
+ * kMaxTicketIdLength (legacy IDs only; UUIDs fit) are truncated.
+ */
+struct ValidationRecord {
+    static constexpr size_t kMaxTicketIdLength = 47;
+
+    char ticketId[kMaxTicketIdLength + 1];
+    char timestamp[Iso8601::kLength + 1];  // UTC
+    char validationMode[8];                // "online", "offline" or "signed"
+    bool valid;
+
+    void setTicketId(std::string_view id) { copy(ticketId, id); }
+    void setValidationMode(std::string_view mode) { copy(validationMode, mode); }
+
+private:
+    template <size_t N>
+    static void copy(char (&field)[N], std::string_view text) {
+        size_t length = std::min(text.size(), N - 1);
+        text.copy(field, length);
+        field[length] = '\0';
+    }
+};
+
+#endif // VALIDATION_RECORD_H
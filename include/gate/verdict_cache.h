@@ -0,0 +1,94 @@
+// include/gate/verdict_cache.h
+#ifndef VERDICT_CACHE_H
+#define VERDICT_CACHE_H
+
+#include <string>
+#include <string_view>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Gate-local cache of recent Back-Office verdicts, keyed by ticket ID
+ *
+ * Period passes are tapped at the same gates again and again; a hit
+ * answers the tap without a Back-Office round trip. An entry lives for
+ * ttl, and never past the ticket's own expiry. Each entry also carries a
+ * fingerprint of the ticket as presented, so a different ticket claiming
+ * a cached ID misses and is asked about online.
+ *
+ * The cache is bounded by an estimate of its memory use (maxBytes) and
+ * evicts the least recently used entries beyond it; maxBytes or ttl of 0
+ * disables it. Times are milliseconds since the Unix epoch, passed in by
+ * the caller. Thread-safe.
+ */
+class VerdictCache {
+public:
+    struct Config {
+        size_t maxBytes = 1 << 20;
+        std::chrono::milliseconds ttl{60000};
+    };
+
+    struct Verdict {
+        bool valid = false;
+        std::string message;
+    };
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;     // Expired and mismatched entries included
+        uint64_t evictions = 0;  // Dropped to stay within maxBytes
+        size_t entries = 0;
+        size_t bytes = 0;
+
+        double hitRate() const {
+            uint64_t lookups = hits + misses;
+            return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+        }
+    };
+
+    VerdictCache();
+    explicit VerdictCache(Config config);
+
+    VerdictCache(const VerdictCache&) = delete;
+    VerdictCache& operator=(const VerdictCache&) = delete;
+
+    bool enabled() const { return config_.maxBytes > 0 && config_.ttl.count() > 0; }
+
+    // Fills verdict and returns true on a live entry with this fingerprint
+    bool lookup(const std::string& ticketId, uint64_t fingerprint, int64_t nowMs, Verdict& verdict);
+
+    // Cache a verdict until min(now + ttl, ticketExpiryMs)
+    void store(const std::string& ticketId, uint64_t fingerprint, const Verdict& verdict,
+               int64_t ticketExpiryMs, int64_t nowMs);
+
+    Stats stats() const;
+
+private:
+    struct Entry {
+        std::string ticketId;
+        uint64_t fingerprint;
+        Verdict verdict;
+        int64_t expiresAtMs;
+        size_t bytes;
+    };
+    using Lru = std::list<Entry>;  // Most recently used first
+
+    Config config_;
+
+    mutable std::mutex mutex_;
+    Lru lru_;
+    std::unordered_map<std::string_view, Lru::iterator> index_;  // Keys view Entry::ticketId
+    size_t bytes_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t evictions_ = 0;
+
+    static size_t footprint(const Entry& entry);
+    void erase(Lru::iterator it);
+};
+
+#endif // VERDICT_CACHE_H
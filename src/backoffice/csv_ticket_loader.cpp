@@ -0,0 +1,192 @@
+// src/backoffice/csv_ticket_loader.cpp
+#include "csv_ticket_loader.h"
+#include "ticket_csv.h"
+#include <string_view>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <iterator>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+
+// Read-only mapping of a whole file
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path)
+        : data_(nullptr), size_(0), opened_(false) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return;
+        opened_ = true;
+
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* mapping = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                data_ = static_cast<const char*>(mapping);
+                size_ = static_cast<size_t>(st.st_size);
+                ::madvise(mapping, size_, MADV_SEQUENTIAL);
+            } else {
+                opened_ = false;
+            }
+        }
+        ::close(fd);
+    }
+
+    ~MappedFile() {
+        if (data_) ::munmap(const_cast<char*>(data_), size_);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool opened() const { return opened_; }
+    std::string_view contents() const { return std::string_view(data_ ? data_ : "", size_); }
+
+private:
+    const char* data_;
+    size_t size_;
+    bool opened_;
+};
+
+// Split the text into up to `count` chunks ending on line boundaries
+std::vector<std::string_view> splitChunks(std::string_view text, size_t count) {
+    std::vector<std::string_view> chunks;
+    size_t begin = 0;
+
+    for (size_t i = 1; i <= count && begin < text.size(); i++) {
+        size_t end = i == count ? text.size() : std::max(begin, text.size() * i / count);
+        if (end < text.size()) {
+            size_t newline = text.find('\n', end);
+            end = newline == std::string_view::npos ? text.size() : newline + 1;
+        }
+        chunks.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+    return chunks;
+}
+
+// Call fn(row) for every well-formed row; returns the number of bad rows
+template <typename Fn>
+size_t parseChunk(std::string_view chunk, Fn&& fn) {
+    size_t badRows = 0;
+    TicketCsv::Row row;
+
+    while (!chunk.empty()) {
+        size_t newline = chunk.find('\n');
+        std::string_view line = chunk.substr(0, newline);
+        chunk.remove_prefix(newline == std::string_view::npos ? chunk.size() : newline + 1);
+
+        if (line.empty() || line == TicketCsv::kHeader) continue;
+        if (TicketCsv::parseRow(line, row)) {
+            fn(row);
+        } else {
+            badRows++;
+        }
+    }
+    return badRows;
+}
+
+Ticket toTicket(const TicketCsv::Row& row) {
+    return Ticket(std::string(row.ticketId), row.creationTime, row.validityDays, row.lineNumber);
+}
+
+template <typename Fn>
+void runParallel(size_t count, Fn&& fn) {
+    std::vector<std::thread> threads;
+    threads.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        threads.emplace_back(fn, i);
+    }
+    for (auto& thread : threads) thread.join();
+}
+
+double secondsSince(std::chrono::steady_clock::time_point started) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+}
+
+} // namespace
+
+CsvTicketLoader::CsvTicketLoader(size_t threadCount)
+    : threadCount_(threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency())) {
+}
+
+bool CsvTicketLoader::loadInto(const std::string& path, TicketStore& store, Stats& stats) const {
+    auto started = std::chrono::steady_clock::now();
+    MappedFile file(path);
+    if (!file.opened()) return false;
+
+    std::vector<std::string_view> chunks = splitChunks(file.contents(), threadCount_);
+    size_t shardCount = store.shardCount();
+
+    // buckets[chunk][shard]; rows point into the mapping, so no ID is
+    // copied until it reaches the store (and Snowflake IDs never are)
+    std::vector<std::vector<std::vector<TicketCsv::Row>>> buckets(chunks.size());
+    std::vector<size_t> badRows(chunks.size(), 0);
+
+    runParallel(chunks.size(), [&](size_t c) {
+        buckets[c].resize(shardCount);
+        badRows[c] = parseChunk(chunks[c], [&](const TicketCsv::Row& row) {
+            buckets[c][store.shardIndex(row.ticketId)].push_back(row);
+        });
+    });
+
+    size_t parsed = 0;
+    for (size_t c = 0; c < chunks.size(); c++) {
+        stats.badRows += badRows[c];
+        for (const auto& bucket : buckets[c]) parsed += bucket.size();
+    }
+    store.reserve(store.size() + parsed);
+
+    // Each merge thread owns every shard congruent to its index
+    size_t mergeThreads = std::min(threadCount_, shardCount);
+    std::vector<size_t> inserted(mergeThreads, 0);
+    runParallel(mergeThreads, [&](size_t t) {
+        for (size_t shard = t; shard < shardCount; shard += mergeThreads) {
+            for (auto& chunkBuckets : buckets) {
+                inserted[t] += store.insertIntoShard(shard, chunkBuckets[shard]);
+                std::vector<TicketCsv::Row>().swap(chunkBuckets[shard]);
+            }
+        }
+    });
+
+    size_t insertedTotal = 0;
+    for (size_t count : inserted) insertedTotal += count;
+
+    stats.rows += parsed;
+    stats.duplicates += parsed - insertedTotal;
+    stats.seconds += secondsSince(started);
+    return true;
+}
+
+bool CsvTicketLoader::load(const std::string& path, std::vector<Ticket>& tickets, Stats& stats) const {
+    auto started = std::chrono::steady_clock::now();
+    MappedFile file(path);
+    if (!file.opened()) return false;
+
+    std::vector<std::string_view> chunks = splitChunks(file.contents(), threadCount_);
+    std::vector<std::vector<Ticket>> parsed(chunks.size());
+    std::vector<size_t> badRows(chunks.size(), 0);
+
+    runParallel(chunks.size(), [&](size_t c) {
+        badRows[c] = parseChunk(chunks[c], [&](const TicketCsv::Row& row) {
+            parsed[c].push_back(toTicket(row));
+        });
+    });
+
+    size_t total = 0;
+    for (const auto& chunk : parsed) total += chunk.size();
+    tickets.reserve(tickets.size() + total);
+
+    for (size_t c = 0; c < chunks.size(); c++) {
+        stats.badRows += badRows[c];
+        std::move(parsed[c].begin(), parsed[c].end(), std::back_inserter(tickets));
+    }
+
+    stats.rows += total;
+    stats.seconds += secondsSince(started);
+    return true;
+}
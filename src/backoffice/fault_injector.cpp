@@ -0,0 +1,210 @@
+// src/backoffice/fault_injector.cpp
+#include "fault_injector.h"
+#include <thread>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+
+namespace {
+
+const char* const kEndpointNames[] = {"create", "validate", "report"};
+const char* const kLatencyNames[] = {"none", "fixed", "uniform", "normal"};
+
+int endpointIndex(const std::string& name) {
+    for (int i = 0; i < FaultInjector::kEndpointCount; i++) {
+        if (name == kEndpointNames[i]) return i;
+    }
+    throw std::invalid_argument("Unknown fault endpoint: " + name);
+}
+
+double parseNumber(const std::string& text, const std::string& what) {
+    try {
+        size_t used = 0;
+        double value = std::stod(text, &used);
+        if (used == text.size() && value >= 0.0) return value;
+    } catch (const std::exception&) {}
+    throw std::invalid_argument("Invalid " + what + ": " + text);
+}
+
+// "100" fixed, "50-150" uniform, "200~20" normal
+void parseLatency(const std::string& text, FaultInjector::Profile& profile) {
+    using Latency = FaultInjector::Profile::Latency;
+    size_t sep = text.find_first_of("-~");
+
+    if (sep == std::string::npos) {
+        profile.latency = Latency::Fixed;
+        profile.latencyMs = parseNumber(text, "latency");
+    } else {
+        profile.latency = text[sep] == '-' ? Latency::Uniform : Latency::Normal;
+        profile.latencyMs = parseNumber(text.substr(0, sep), "latency");
+        profile.latencyMaxMs = parseNumber(text.substr(sep + 1), "latency");
+    }
+}
+
+// JSON input skips parseNumber, so every bound is checked here as well
+void validate(const FaultInjector::Profile& profile) {
+    using Latency = FaultInjector::Profile::Latency;
+    if (!(profile.errorRate >= 0.0 && profile.errorRate <= 1.0)) {
+        throw std::invalid_argument("Fault error rate must be between 0 and 1");
+    }
+    if (!(profile.latencyMs >= 0.0) || !(profile.latencyMaxMs >= 0.0)) {
+        throw std::invalid_argument("Fault latency must not be negative");
+    }
+    if (profile.latency == Latency::Uniform && profile.latencyMaxMs < profile.latencyMs) {
+        throw std::invalid_argument("Uniform latency maximum is below its minimum");
+    }
+    // std::normal_distribution requires a positive standard deviation
+    if (profile.latency == Latency::Normal && profile.latencyMaxMs <= 0.0) {
+        throw std::invalid_argument("Normal latency deviation must be positive");
+    }
+}
+
+} // namespace
+
+FaultInjector::FaultInjector()
+    : enabled_(false) {
+}
+
+void FaultInjector::configure(const Config& config) {
+    for (const auto& profile : config.endpoints) {
+        validate(profile);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+    generator_.seed(config.seed);
+    enabled_.store(config.enabled, std::memory_order_relaxed);
+}
+
+FaultInjector::Config FaultInjector::config() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+void FaultInjector::injectSlow(Endpoint endpoint) {
+    double delayMs = 0.0;
+    bool fail = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const Profile& profile = config_.endpoints[static_cast<int>(endpoint)];
+
+        switch (profile.latency) {
+        case Profile::Latency::None:
+            break;
+        case Profile::Latency::Fixed:
+            delayMs = profile.latencyMs;
+            break;
+        case Profile::Latency::Uniform:
+            delayMs = std::uniform_real_distribution<double>(profile.latencyMs, profile.latencyMaxMs)(generator_);
+            break;
+        case Profile::Latency::Normal:
+            delayMs = std::normal_distribution<double>(profile.latencyMs, profile.latencyMaxMs)(generator_);
+            break;
+        }
+
+        if (profile.errorRate > 0.0) {
+            fail = std::uniform_real_distribution<double>(0.0, 1.0)(generator_) < profile.errorRate;
+        }
+    }
+
+    if (delayMs > 0.0) {
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(delayMs));
+    }
+    if (fail) {
+        throw std::runtime_error(std::string("Simulated ") + endpointName(endpoint) + " service failure");
+    }
+}
+
+FaultInjector::Config FaultInjector::parseSpec(const std::string& spec) {
+    Config config;
+    std::stringstream sections(spec);
+    std::string section;
+
+    while (std::getline(sections, section, ';')) {
+        if (section.empty()) continue;
+
+        if (section.rfind("seed=", 0) == 0) {
+            try {
+                config.seed = std::stoull(section.substr(5));
+            } catch (const std::exception&) {
+                throw std::invalid_argument("Invalid fault seed: " + section);
+            }
+            continue;
+        }
+
+        size_t colon = section.find(':');
+        if (colon == std::string::npos) {
+            throw std::invalid_argument("Expected <endpoint>:<settings>, got: " + section);
+        }
+        Profile& profile = config.endpoints[endpointIndex(section.substr(0, colon))];
+
+        std::stringstream settings(section.substr(colon + 1));
+        std::string setting;
+        while (std::getline(settings, setting, ',')) {
+            size_t eq = setting.find('=');
+            std::string key = setting.substr(0, eq);
+            std::string value = eq == std::string::npos ? "" : setting.substr(eq + 1);
+
+            if (key == "latency") {
+                parseLatency(value, profile);
+            } else if (key == "error") {
+                profile.errorRate = parseNumber(value, "error rate");
+            } else {
+                throw std::invalid_argument("Unknown fault setting: " + setting);
+            }
+        }
+        validate(profile);
+    }
+
+    config.enabled = !spec.empty();
+    return config;
+}
+
+FaultInjector::Config FaultInjector::fromJson(const json& j) {
+    Config config;
+    config.enabled = j.value("enabled", true);
+    config.seed = j.value("seed", uint64_t{0});
+
+    if (j.contains("endpoints")) {
+        for (const auto& item : j.at("endpoints").items()) {
+            Profile& profile = config.endpoints[endpointIndex(item.key())];
+            const json& e = item.value();
+
+            std::string distribution = e.value("latency", std::string("none"));
+            const auto* name = std::find(std::begin(kLatencyNames), std::end(kLatencyNames), distribution);
+            if (name == std::end(kLatencyNames)) {
+                throw std::invalid_argument("Unknown latency distribution: " + distribution);
+            }
+            profile.latency = static_cast<Profile::Latency>(name - std::begin(kLatencyNames));
+            profile.latencyMs = e.value("latencyMs", 0.0);
+            profile.latencyMaxMs = e.value("latencyMaxMs", 0.0);
+            profile.errorRate = e.value("errorRate", 0.0);
+            validate(profile);
+        }
+    }
+    return config;
+}
+
+json FaultInjector::toJson(const Config& config) {
+    json endpoints = json::object();
+    for (int i = 0; i < kEndpointCount; i++) {
+        const Profile& profile = config.endpoints[i];
+        endpoints[kEndpointNames[i]] = {
+            {"latency", kLatencyNames[static_cast<int>(profile.latency)]},
+            {"latencyMs", profile.latencyMs},
+            {"latencyMaxMs", profile.latencyMaxMs},
+            {"errorRate", profile.errorRate}
+        };
+    }
+
+    return json{
+        {"enabled", config.enabled},
+        {"seed", config.seed},
+        {"endpoints", endpoints}
+    };
+}
+
+const char* FaultInjector::endpointName(Endpoint endpoint) {
+    return kEndpointNames[static_cast<int>(endpoint)];
+}
@@ -5,10 +5,25 @@
 #include <fstream>
 #include <sstream>
 #include <mutex>
-#include <random>
+#include <memory>
+#include <algorithm>
+#include <cstdlib>
 #include <thread>
 #include <chrono>
+#include <utility>
 #include "ticket.h"
+#include "ticket_journal.h"
+#include "ticket_store.h"
+#include "ticket_csv.h"
+#include "csv_ticket_loader.h"
+#include "ticket_snapshot.h"
+#include "fault_injector.h"
+#include "ticket_id.h"
+#include "ticket_signer.h"
+#include "ticket_validator.h"
+#include "ticket_codec.h"
+#include "coarse_clock.h"
+#include "payload_codec.h"
 
 using json = nlohmann::json;
 
@@ -16,19 +31,38 @@ using json = nlohmann::json;
  * @brief Back-Office Service
  * 
  * Responsibilities (as per requirements):
- * - Sale: Generate ticket ID, create tickets, store in CSV
+ * - Sale: Generate ticket ID, create tickets, store in CSV (snapshot + journal)
  * - Validation: Validate tickets against database
  * - Transactions: Receive and store reports from gates
+ *
+ * Latency and failures are only simulated when configured (see FaultInjector).
+ * The unauthenticated /api/admin/faults endpoint that changes them at
+ * runtime is only served when enabled with --fault-admin.
+ * With a signing keyring (see TicketSigner) issued tickets are signed and
+ * validation rejects tickets whose signature does not verify. Every ticket
+ * is judged by its stored record (see TicketValidator).
  */
 class BackOfficeService {
 public:
-    BackOfficeService(const std::string& host, int port, const std::string& stockFile)
-        : host_(host), port_(port), stockFile_(stockFile), ticketCounter_(0) {
+    BackOfficeService(const std::string& host, int port, const std::string& stockFile,
+                      size_t workerCount, uint32_t nodeId, const FaultInjector::Config& faults,
+                      bool faultAdmin, TicketSigner signer)
+        : host_(host), port_(port), stockFile_(stockFile), faultAdmin_(faultAdmin),
+          binarySnapshot_(TicketSnapshot::isSnapshotPath(stockFile) ||
+                          TicketSnapshot::isSnapshotFile(stockFile)),
+          workerCount_(workerCount),
+          store_(workerCount * 8), ticketIds_(nodeId), signer_(std::move(signer)),
+          validator_(store_),
+          journal_(stockFile, [this](const std::string& path) { saveTickets(path); }) {
+        faults_.configure(faults);
         loadTickets();
+        journal_.open();
     }
 
     void start() {
         httplib::Server server;
+        size_t workers = workerCount_;
+        server.new_task_queue = [workers] { return new httplib::ThreadPool(workers); };
         
         // Health check endpoint
         server.Get("/health", [](const httplib::Request&, httplib::Response& res) {
@@ -40,33 +74,58 @@ public:
             handleTicketCreation(req, res);
         });
 
+        // Batch ticket creation (group sales, pre-printed stock)
+        server.Post("/api/tickets/create/batch", [this](const httplib::Request& req, httplib::Response& res) {
+            handleBatchCreation(req, res);
+        });
+
         // Ticket validation endpoint
         server.Post("/api/tickets/validate", [this](const httplib::Request& req, httplib::Response& res) {
             handleTicketValidation(req, res);
         });
 
+        // Batch validation (several taps at a busy gate)
+        server.Post("/api/tickets/validate/batch", [this](const httplib::Request& req, httplib::Response& res) {
+            handleBatchValidation(req, res);
+        });
+
         // Report endpoint (from gates)
         server.Post("/api/reports", [this](const httplib::Request& req, httplib::Response& res) {
             handleReport(req, res);
         });
 
-        // Get all tickets (for debugging/testing)
-        server.Get("/api/tickets", [this](const httplib::Request&, httplib::Response& res) {
-            std::lock_guard<std::mutex> lock(ticketMutex_);
-            json j = json::array();
-            for (const auto& ticket : tickets_) {
-                j.push_back(json::parse(ticket.toJson()));
-            }
-            res.set_content(j.dump(2), "application/json");
+        // List tickets: streamed in full, or one page per ?limit=&after=
+        server.Get("/api/tickets", [this](const httplib::Request& req, httplib::Response& res) {
+            handleTicketList(req, res);
         });
 
+        // Fault injection settings (latency / failure simulation); no
+        // authentication, so only served when explicitly enabled
+        if (faultAdmin_) {
+            server.Get("/api/admin/faults", [this](const httplib::Request&, httplib::Response& res) {
+                res.set_content(FaultInjector::toJson(faults_.config()).dump(2), "application/json");
+            });
+
+            server.Post("/api/admin/faults", [this](const httplib::Request& req, httplib::Response& res) {
+                handleFaultConfig(req, res);
+            });
+        }
+
         std::cout << "╔════════════════════════════════════════╗" << std::endl;
         std::cout << "║   Back-Office Service Starting...     ║" << std::endl;
         std::cout << "╚════════════════════════════════════════╝" << std::endl;
         std::cout << "Host: " << host_ << std::endl;
         std::cout << "Port: " << port_ << std::endl;
-        std::cout << "Stock File: " << stockFile_ << std::endl;
-        std::cout << "Loaded Tickets: " << tickets_.size() << std::endl;
+        std::cout << "Stock File: " << stockFile_ << (binarySnapshot_ ? " (binary)" : " (CSV)") << std::endl;
+        std::cout << "Journal: " << journal_.journalPath() << std::endl;
+        std::cout << "Loaded Tickets: " << store_.size() << std::endl;
+        std::cout << "Node ID: " << ticketIds_.nodeId() << std::endl;
+        std::cout << "Ticket Signing: "
+                  << (signer_.canSign() ? "key " + std::to_string(signer_.activeKey()) : std::string("disabled"))
+                  << std::endl;
+        std::cout << "Workers: " << workerCount_ << " (" << store_.shardCount() << " store shards)" << std::endl;
+        std::cout << "Fault Injection: " << (faults_.enabled() ? "enabled" : "disabled")
+                  << (faultAdmin_ ? " (admin API on)" : "") << std::endl;
         std::cout << "----------------------------------------" << std::endl;
         
         server.listen(host_.c_str(), port_);
@@ -76,73 +135,201 @@ private:
     std::string host_;
     int port_;
     std::string stockFile_;
-    std::vector<Ticket> tickets_;
-    std::mutex ticketMutex_;
-    int ticketCounter_;
+    bool faultAdmin_;
+    bool binarySnapshot_;
+    size_t workerCount_;
+    TicketStore store_;
+    TicketIdAllocator ticketIds_;
+    TicketSigner signer_;
+    TicketValidator validator_;
     std::vector<std::string> reports_;
+    std::mutex reportMutex_;
+    FaultInjector faults_;
+    TicketJournal journal_;
 
-    // Generate unique ticket ID
-    std::string generateTicketId() {
-        auto timestamp = std::chrono::system_clock::now().time_since_epoch().count();
-        return "TKT-" + std::to_string(++ticketCounter_) + "-" + std::to_string(timestamp);
-    }
-
-    // Load tickets from CSV file
+    // Load the snapshot (binary or CSV), then replay the journal on top
     void loadTickets() {
-        std::ifstream file(stockFile_);
-        if (!file.is_open()) {
+        auto started = std::chrono::steady_clock::now();
+
+        if (TicketSnapshot::isSnapshotFile(stockFile_)) {
+            loadSnapshotFile(stockFile_);
+        } else if (!loadCsvFile(stockFile_)) {
             std::cout << "⚠ Stock file not found. Starting with empty database." << std::endl;
+        }
+        for (const auto& path : journal_.replayPaths()) {
+            loadCsvFile(path);
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - started);
+        std::cout << "Loaded " << store_.size() << " tickets in " << elapsed.count() << " ms" << std::endl;
+    }
+
+    // Records go from the mapping into the store shards as packed records,
+    // without building a Ticket per row
+    void loadSnapshotFile(const std::string& path) {
+        auto started = std::chrono::steady_clock::now();
+        TicketSnapshot snapshot(path);
+        size_t inserted = snapshot.loadInto(store_);
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        std::cout << "  " << path << ": " << snapshot.size() << " records in "
+                  << static_cast<long long>(seconds * 1000) << " ms ("
+                  << static_cast<long long>(seconds > 0.0 ? snapshot.size() / seconds : 0.0) << " records/s)";
+        if (inserted < snapshot.size()) std::cout << ", " << snapshot.size() - inserted << " duplicates";
+        std::cout << std::endl;
+    }
+
+    bool loadCsvFile(const std::string& path) {
+        CsvTicketLoader loader;
+        CsvTicketLoader::Stats stats;
+
+        // Rows already in the snapshot may be replayed again from the journal
+        if (!loader.loadInto(path, store_, stats)) {
+            return false;
+        }
+
+        std::cout << "  " << path << ": " << stats.rows << " rows, "
+                  << static_cast<long long>(stats.rowsPerSecond()) << " rows/s ("
+                  << loader.threadCount() << " threads)";
+        if (stats.duplicates > 0) std::cout << ", " << stats.duplicates << " duplicates";
+        std::cout << std::endl;
+        if (stats.badRows > 0) {
+            std::cerr << "⚠ Skipped " << stats.badRows << " malformed rows in " << path << std::endl;
+        }
+        return true;
+    }
+
+    // Write a full snapshot in the stock file's format (used by journal compaction)
+    void saveTickets(const std::string& path) {
+        if (binarySnapshot_) {
+            TicketSnapshot::write(path, store_.snapshot());
+        } else {
+            TicketCsv::writeFile(path, store_.snapshot());
+        }
+    }
+
+    static constexpr size_t kStreamChunkTickets = 1000;
+    static constexpr size_t kDefaultPageSize = 100;
+    static constexpr size_t kMaxPageSize = 1000;
+
+    // Opaque pagination cursor: hex of (shard << 40 | offset)
+    static std::string encodeCursor(const TicketStore::Cursor& cursor) {
+        std::ostringstream oss;
+        oss << std::hex << ((static_cast<uint64_t>(cursor.shard) << 40) | cursor.offset);
+        return oss.str();
+    }
+
+    bool decodeCursor(const std::string& text, TicketStore::Cursor& cursor) const {
+        if (text.empty() || text.size() > 16 ||
+            text.find_first_not_of("0123456789abcdef") != std::string::npos) {
+            return false;
+        }
+        uint64_t value = std::stoull(text, nullptr, 16);
+        cursor.shard = static_cast<size_t>(value >> 40);
+        cursor.offset = static_cast<size_t>(value & ((uint64_t{1} << 40) - 1));
+        return cursor.shard < store_.shardCount();
+    }
+
+    // Tickets are copied a page at a time under each shard's read lock and
+    // serialized afterwards, so listing never blocks sales or validations.
+    // A listing covers the tickets present when it started.
+    void handleTicketList(const httplib::Request& req, httplib::Response& res) {
+        if (!req.has_param("limit") && !req.has_param("after")) {
+            streamAllTickets(res);
             return;
         }
 
-        std::string line;
-        std::getline(file, line); // Skip header
-        
-        while (std::getline(file, line)) {
-            if (line.empty()) continue;
-            
-            std::stringstream ss(line);
-            std::string id, date, validity, lineNum;
-            
-            std::getline(ss, id, ',');
-            std::getline(ss, date, ',');
-            std::getline(ss, validity, ',');
-            std::getline(ss, lineNum, ',');
-            
-            if (!id.empty()) {
-                Ticket ticket(id, std::stoi(validity), std::stoi(lineNum));
-                ticket.setCreationDate(date);
-                tickets_.push_back(ticket);
-                
-                // Update counter to avoid ID collision
-                size_t pos = id.find('-');
-                if (pos != std::string::npos) {
-                    try {
-                        int num = std::stoi(id.substr(pos + 1));
-                        if (num > ticketCounter_) {
-                            ticketCounter_ = num;
-                        }
-                    } catch (...) {}
-                }
+        size_t limit = kDefaultPageSize;
+        TicketStore::Cursor cursor;
+        try {
+            if (req.has_param("limit")) {
+                limit = std::stoul(req.get_param_value("limit"));
+            }
+            if (limit == 0 || limit > kMaxPageSize) {
+                throw std::invalid_argument("limit must be between 1 and " + std::to_string(kMaxPageSize));
             }
+            if (req.has_param("after") && !decodeCursor(req.get_param_value("after"), cursor)) {
+                throw std::invalid_argument("Invalid cursor");
+            }
+        } catch (const std::exception& e) {
+            json error = {{"success", false}, {"error", e.what()}};
+            res.status = 400;
+            res.set_content(error.dump(), "application/json");
+            return;
         }
-        
-        file.close();
-    }
 
-    // Save tickets to CSV file
-    void saveTickets() {
-        std::ofstream file(stockFile_);
-        file << "TicketID,CreationDate,ValidityDays,LineNumber\n";
-        
-        for (const auto& ticket : tickets_) {
-            file << ticket.getId() << ","
-                 << ticket.getCreationDate() << ","
-                 << ticket.getValidityDays() << ","
-                 << ticket.getLineNumber() << "\n";
+        std::vector<Ticket> page;
+        page.reserve(limit);
+        store_.copyPage(cursor, store_.shardSizes(), limit, page);
+
+        std::string body = "{\"tickets\":[";
+        for (size_t i = 0; i < page.size(); i++) {
+            if (i > 0) body += ',';
+            body += page[i].toJson();
         }
-        
-        file.close();
+        body += "],\"next\":";
+        body += cursor.shard < store_.shardCount() ? "\"" + encodeCursor(cursor) + "\"" : "null";
+        body += '}';
+
+        res.set_content(body, "application/json");
+    }
+
+    void streamAllTickets(httplib::Response& res) {
+        struct StreamState {
+            TicketStore::Cursor cursor;
+            std::vector<size_t> bounds;
+            std::vector<Ticket> page;
+            std::string chunk;
+            bool started = false;
+            bool empty = true;
+        };
+        auto state = std::make_shared<StreamState>();
+        state->bounds = store_.shardSizes();
+
+        res.set_chunked_content_provider("application/json",
+            [this, state](size_t, httplib::DataSink& sink) {
+                state->page.clear();
+                state->chunk.clear();
+                if (!state->started) {
+                    state->chunk += '[';
+                    state->started = true;
+                }
+
+                store_.copyPage(state->cursor, state->bounds, kStreamChunkTickets, state->page);
+                for (const auto& ticket : state->page) {
+                    if (!state->empty) state->chunk += ',';
+                    state->chunk += ticket.toJson();
+                    state->empty = false;
+                }
+
+                bool finished = state->cursor.shard >= store_.shardCount();
+                if (finished) state->chunk += ']';
+
+                if (!sink.write(state->chunk.data(), state->chunk.size())) {
+                    return false;
+                }
+                if (finished) sink.done();
+                return true;
+            });
+    }
+
+    // Ticket endpoints speak JSON, CBOR or MessagePack: the request body is
+    // read per Content-Type (JSON when absent or unrecognized) and the
+    // response written per Accept, defaulting to the request's format
+    static PayloadFormat requestFormat(const httplib::Request& req) {
+        PayloadFormat format = PayloadFormat::Json;
+        PayloadCodec::fromContentType(req.get_header_value("Content-Type"), format);
+        return format;
+    }
+
+    static json readBody(const httplib::Request& req) {
+        return PayloadCodec::parse(req.body, requestFormat(req));
+    }
+
+    static void reply(const httplib::Request& req, httplib::Response& res, const json& body) {
+        PayloadFormat format = PayloadCodec::negotiate(req.get_header_value("Accept"), requestFormat(req));
+        res.set_content(PayloadCodec::dump(body, format), PayloadCodec::contentType(format));
     }
 
     // Handle ticket creation request (SALE)
@@ -150,7 +337,7 @@ private:
         try {
             std::cout << "\n=== Ticket Creation Request ===" << std::endl;
             
-            json requestData = json::parse(req.body);
+            json requestData = readBody(req);
             
             int validityDays = requestData["validityDays"];
             int lineNumber = requestData["lineNumber"];
@@ -158,37 +345,113 @@ private:
             std::cout << "Validity Days: " << validityDays << std::endl;
             std::cout << "Line Number: " << lineNumber << std::endl;
             
-            // Generate unique ticket ID
-            std::string ticketId = generateTicketId();
+            // Unique across back-office nodes, no lock needed
+            std::string ticketId = ticketIds_.nextString();
             Ticket ticket(ticketId, validityDays, lineNumber);
             
-            // Simulate processing delay (realistic scenario)
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            faults_.inject(FaultInjector::Endpoint::Create);
             
-            {
-                std::lock_guard<std::mutex> lock(ticketMutex_);
-                tickets_.push_back(ticket);
-                saveTickets();
-            }
+            // Stored only once the journal group commit containing it has
+            // synced, so a failed sale leaves no live ticket behind
+            journal_.append({TicketCsv::formatRow(ticket)}, [&] {
+                if (!store_.insert(ticket)) {
+                    throw std::runtime_error("Duplicate ticket ID: " + ticket.getId());
+                }
+            });
             
             // Prepare response with Base64 ticket
+            std::string ticketBase64 = encodeTicket(ticket);
             json response = {
                 {"success", true},
                 {"ticketId", ticket.getId()},
                 {"ticket", ticket.toJson()},
-                {"ticketBase64", ticket.toBase64()}
+                {"ticketBase64", ticketBase64}
             };
             
             std::cout << "✓ Ticket Created: " << ticket.getId() << std::endl;
-            std::cout << "  Base64: " << ticket.toBase64().substr(0, 30) << "..." << std::endl;
+            std::cout << "  Base64: " << ticketBase64.substr(0, 30) << "..." << std::endl;
             
-            res.set_content(response.dump(), "application/json");
+            reply(req, res, response);
             
         } catch (const std::exception& e) {
             std::cerr << "✗ Error: " << e.what() << std::endl;
             json error = {{"success", false}, {"error", e.what()}};
             res.status = 400;
-            res.set_content(error.dump(), "application/json");
+            reply(req, res, error);
+        }
+    }
+
+    static constexpr size_t kMaxBatchSize = 1000;
+
+    // Handle batch creation: IDs come from one allocator block, the rows are
+    // journaled with a single group commit and all tickets are returned at once
+    void handleBatchCreation(const httplib::Request& req, httplib::Response& res) {
+        try {
+            json requestData = readBody(req);
+            const json& items = requestData.is_object() ? requestData.at("tickets") : requestData;
+
+            if (!items.is_array() || items.empty()) {
+                throw std::invalid_argument("Expected a non-empty array of tickets");
+            }
+            if (items.size() > kMaxBatchSize) {
+                throw std::invalid_argument("Batch exceeds " + std::to_string(kMaxBatchSize) + " tickets");
+            }
+
+            std::cout << "\n=== Batch Ticket Creation Request (" << items.size() << " tickets) ===" << std::endl;
+
+            std::vector<uint64_t> ids = ticketIds_.allocateBlock(items.size());
+            std::vector<Ticket> tickets;
+            tickets.reserve(items.size());
+            for (size_t i = 0; i < items.size(); i++) {
+                tickets.emplace_back(TicketIdAllocator::encode(ids[i]),
+                                     items[i].at("validityDays").get<int>(),
+                                     items[i].at("lineNumber").get<int>());
+            }
+
+            faults_.inject(FaultInjector::Endpoint::Create);
+
+            std::vector<std::string> rows;
+            rows.reserve(tickets.size());
+            for (const auto& ticket : tickets) {
+                rows.push_back(TicketCsv::formatRow(ticket));
+            }
+            journal_.append(rows, [&] {
+                if (store_.insertMany(tickets) != tickets.size()) {
+                    throw std::runtime_error("Duplicate ticket ID in batch");
+                }
+            });
+
+            // Every ticket encoded into one buffer
+            std::string encoded;
+            std::vector<size_t> ends;
+            TicketCodec::encodeMany(tickets, encoded, ends, &signer_);
+
+            json created = json::array();
+            size_t begin = 0;
+            for (size_t i = 0; i < tickets.size(); i++) {
+                created.push_back({
+                    {"ticketId", tickets[i].getId()},
+                    {"ticketBase64", encoded.substr(begin, ends[i] - begin)}
+                });
+                begin = ends[i];
+            }
+
+            json response = {
+                {"success", true},
+                {"count", tickets.size()},
+                {"tickets", created}
+            };
+
+            std::cout << "✓ Tickets Created: " << tickets.front().getId() << " .. "
+                      << tickets.back().getId() << std::endl;
+
+            reply(req, res, response);
+
+        } catch (const std::exception& e) {
+            std::cerr << "✗ Error: " << e.what() << std::endl;
+            json error = {{"success", false}, {"error", e.what()}};
+            res.status = 400;
+            reply(req, res, error);
         }
     }
 
@@ -197,67 +460,131 @@ private:
         try {
             std::cout << "\n=== Ticket Validation Request ===" << std::endl;
             
-            json requestData = json::parse(req.body);
-            std::string ticketBase64 = requestData["ticketBase64"];
+            json requestData = readBody(req);
+            const std::string& ticketBase64 = requestData.at("ticketBase64").get_ref<const std::string&>();
             
-            // Simulate occasional failures (10% chance) for retry testing
-            std::random_device rd;
-            std::mt19937 gen(rd());
-            std::uniform_int_distribution<> dis(1, 10);
+            // Simulated latency / failures for retry testing (off by default)
+            faults_.inject(FaultInjector::Endpoint::Validate);
             
-            if (dis(gen) == 1) {
-                throw std::runtime_error("Simulated validation service failure");
+            Ticket ticket;
+            TicketSigner::Status signature = signer_.verify(ticketBase64, ticket);
+            if (signature == TicketSigner::Status::Malformed) {
+                throw std::invalid_argument("Invalid ticket data");
             }
             
-            // Simulate processing delay
-            std::this_thread::sleep_for(std::chrono::milliseconds(200));
-            
-            Ticket ticket = Ticket::fromBase64(ticketBase64);
-            
             std::cout << "Ticket ID: " << ticket.getId() << std::endl;
             std::cout << "Line Number: " << ticket.getLineNumber() << std::endl;
             
-            bool exists = false;
-            bool isValid = false;
-            std::string message;
-            
-            {
-                std::lock_guard<std::mutex> lock(ticketMutex_);
-                for (const auto& t : tickets_) {
-                    if (t.getId() == ticket.getId()) {
-                        exists = true;
-                        break;
-                    }
-                }
-            }
-            
-            if (!exists) {
-                message = "Ticket not found in database";
-            } else if (ticket.isExpired()) {
-                message = "Ticket expired";
-            } else {
-                isValid = true;
-                message = "Ticket is valid";
-            }
+            TicketValidator::Verdict verdict = validator_.check(ticket, signature);
             
             json response = {
                 {"success", true},
-                {"valid", isValid},
-                {"message", message},
+                {"valid", verdict.valid},
+                {"message", verdict.message},
                 {"ticketId", ticket.getId()},
                 {"lineNumber", ticket.getLineNumber()}
             };
             
-            std::cout << "Result: " << (isValid ? "✓ VALID" : "✗ INVALID") << std::endl;
-            std::cout << "Message: " << message << std::endl;
+            std::cout << "Result: " << (verdict.valid ? "✓ VALID" : "✗ INVALID") << std::endl;
+            std::cout << "Message: " << verdict.message << std::endl;
             
-            res.set_content(response.dump(), "application/json");
+            reply(req, res, response);
             
         } catch (const std::exception& e) {
             std::cerr << "✗ Validation Error: " << e.what() << std::endl;
             json error = {{"success", false}, {"error", e.what()}};
             res.status = 500;
-            res.set_content(error.dump(), "application/json");
+            reply(req, res, error);
+        }
+    }
+
+    // Signed when a signing key is configured and the ticket has a binary form
+    std::string encodeTicket(const Ticket& ticket) const {
+        std::string base64;
+        if (!signer_.sign(ticket, base64)) {
+            base64 = ticket.toBase64();
+        }
+        return base64;
+    }
+
+    // Handle batch validation: every ticket is decoded first, then the store
+    // is queried once for the whole batch. Results keep the request order;
+    // a ticket that cannot be decoded gets its own error entry.
+    void handleBatchValidation(const httplib::Request& req, httplib::Response& res) {
+        try {
+            json requestData = readBody(req);
+            const json& items = requestData.is_object() ? requestData.at("tickets") : requestData;
+
+            if (!items.is_array() || items.empty()) {
+                throw std::invalid_argument("Expected a non-empty array of ticketBase64 values");
+            }
+            if (items.size() > kMaxBatchSize) {
+                throw std::invalid_argument("Batch exceeds " + std::to_string(kMaxBatchSize) + " tickets");
+            }
+
+            std::cout << "\n=== Batch Validation Request (" << items.size() << " tickets) ===" << std::endl;
+
+            faults_.inject(FaultInjector::Endpoint::Validate);
+
+            std::vector<Ticket> tickets(items.size());
+            std::vector<TicketSigner::Status> signatures(items.size(), TicketSigner::Status::Malformed);
+            std::vector<std::string> errors(items.size());
+            std::vector<const Ticket*> decodedTickets;
+            std::vector<TicketSigner::Status> decodedSignatures;
+            std::vector<size_t> decoded;
+            decodedTickets.reserve(items.size());
+            decodedSignatures.reserve(items.size());
+            decoded.reserve(items.size());
+
+            for (size_t i = 0; i < items.size(); i++) {
+                if (items[i].is_string()) {
+                    signatures[i] = signer_.verify(items[i].get_ref<const std::string&>(), tickets[i]);
+                }
+                if (signatures[i] != TicketSigner::Status::Malformed) {
+                    decodedTickets.push_back(&tickets[i]);
+                    decodedSignatures.push_back(signatures[i]);
+                    decoded.push_back(i);
+                } else {
+                    errors[i] = "Invalid ticket data";
+                }
+            }
+
+            std::vector<TicketValidator::Verdict> verdicts = validator_.checkMany(decodedTickets, decodedSignatures);
+
+            json results = json::array();
+            size_t validCount = 0;
+            size_t next = 0;
+            for (size_t i = 0; i < items.size(); i++) {
+                if (next < decoded.size() && decoded[next] == i) {
+                    const TicketValidator::Verdict& verdict = verdicts[next++];
+                    if (verdict.valid) validCount++;
+                    results.push_back({
+                        {"valid", verdict.valid},
+                        {"message", verdict.message},
+                        {"ticketId", tickets[i].getId()},
+                        {"lineNumber", tickets[i].getLineNumber()}
+                    });
+                } else {
+                    results.push_back({{"valid", false}, {"error", errors[i]}});
+                }
+            }
+
+            json response = {
+                {"success", true},
+                {"count", items.size()},
+                {"validCount", validCount},
+                {"results", results}
+            };
+
+            std::cout << "Result: " << validCount << "/" << items.size() << " valid" << std::endl;
+
+            reply(req, res, response);
+
+        } catch (const std::exception& e) {
+            std::cerr << "✗ Validation Error: " << e.what() << std::endl;
+            json error = {{"success", false}, {"error", e.what()}};
+            res.status = 500;
+            reply(req, res, error);
         }
     }
 
@@ -266,7 +593,12 @@ private:
         try {
             std::cout << "\n=== Report Received ===" << std::endl;
             
-            reports_.push_back(req.body);
+            faults_.inject(FaultInjector::Endpoint::Report);
+            
+            {
+                std::lock_guard<std::mutex> lock(reportMutex_);
+                reports_.push_back(req.body);
+            }
             
             // Log first few lines of report
             std::istringstream iss(req.body);
@@ -280,6 +612,19 @@ private:
             json response = {{"success", true}, {"message", "Report received"}};
             res.set_content(response.dump(), "application/json");
             
+        } catch (const std::exception& e) {
+            json error = {{"success", false}, {"error", e.what()}};
+            res.status = 500;
+            res.set_content(error.dump(), "application/json");
+        }
+    }
+
+    // Replace the fault injection settings at runtime
+    void handleFaultConfig(const httplib::Request& req, httplib::Response& res) {
+        try {
+            faults_.configure(FaultInjector::fromJson(json::parse(req.body)));
+            std::cout << "Fault injection " << (faults_.enabled() ? "enabled" : "disabled") << std::endl;
+            res.set_content(FaultInjector::toJson(faults_.config()).dump(), "application/json");
         } catch (const std::exception& e) {
             json error = {{"success", false}, {"error", e.what()}};
             res.status = 400;
@@ -293,11 +638,48 @@ int main(int argc, char* argv[]) {
     int port = 8080;
     std::string stockFile = "../data/tickets.csv";
     
+    size_t workers = std::max(8u, std::thread::hardware_concurrency());
+    
+    // Fault injection: BACKOFFICE_FAULTS, overridden by --faults=<spec>
+    const char* faultEnv = std::getenv("BACKOFFICE_FAULTS");
+    std::string faultSpec = faultEnv ? faultEnv : "";
+    // Runtime changes through /api/admin/faults: BACKOFFICE_FAULT_ADMIN=1 or --fault-admin
+    const char* faultAdminEnv = std::getenv("BACKOFFICE_FAULT_ADMIN");
+    bool faultAdmin = faultAdminEnv && std::string(faultAdminEnv) == "1";
+    
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--faults=", 0) == 0) {
+            faultSpec = arg.substr(9);
+        } else if (arg == "--fault-admin") {
+            faultAdmin = true;
+        } else {
+            args.push_back(arg);
+        }
+    }
+    
     // Allow command line arguments
-    if (argc > 1) port = std::atoi(argv[1]);
-    if (argc > 2) stockFile = argv[2];
+    if (args.size() > 0) port = std::atoi(args[0].c_str());
+    if (args.size() > 1) stockFile = args[1];
+    if (args.size() > 2) workers = static_cast<size_t>(std::max(1, std::atoi(args[2].c_str())));
     
-    BackOfficeService service(host, port, stockFile);
+    FaultInjector::Config faults;
+    uint32_t nodeId = 0;
+    TicketSigner signer;
+    try {
+        faults = FaultInjector::parseSpec(faultSpec);
+        nodeId = TicketIdAllocator::nodeIdFromEnvironment();
+        signer = TicketSigner::fromEnvironment();
+    } catch (const std::exception& e) {
+        std::cerr << "✗ Invalid configuration: " << e.what() << std::endl;
+        return 1;
+    }
+    
+    // Expiry checks read the cached clock instead of the system clock
+    CoarseClock::start();
+
+    BackOfficeService service(host, port, stockFile, workers, nodeId, faults, faultAdmin, std::move(signer));
     service.start();
     
     return 0;
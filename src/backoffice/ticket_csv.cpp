@@ -0,0 +1,69 @@
+// src/backoffice/ticket_csv.cpp
+#include "ticket_csv.h"
+#include "iso8601.h"
+#include <fstream>
+#include <stdexcept>
+#include <charconv>
+
+const char* const TicketCsv::kHeader = "TicketID,CreationDate,ValidityDays,LineNumber";
+
+namespace {
+
+// Next comma-separated field; advances line past the separator
+std::string_view nextField(std::string_view& line) {
+    size_t comma = line.find(',');
+    std::string_view field = line.substr(0, comma);
+    line.remove_prefix(comma == std::string_view::npos ? line.size() : comma + 1);
+    return field;
+}
+
+bool parseInt(std::string_view field, int& value) {
+    const char* end = field.data() + field.size();
+    auto result = std::from_chars(field.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+} // namespace
+
+std::string TicketCsv::formatRow(const Ticket& ticket) {
+    std::string row;
+    row.reserve(ticket.getId().size() + 40);
+    row += ticket.getId();
+    row += ',';
+    char date[Iso8601::kLength];
+    Iso8601::format(ticket.getCreationTime(), date);
+    row.append(date, sizeof(date));
+    row += ',';
+    row += std::to_string(ticket.getValidityDays());
+    row += ',';
+    row += std::to_string(ticket.getLineNumber());
+    return row;
+}
+
+bool TicketCsv::parseRow(std::string_view line, Row& row) {
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+
+    row.ticketId = nextField(line);
+    std::string_view creationDate = nextField(line);
+    std::string_view validity = nextField(line);
+    std::string_view lineNumber = nextField(line);
+
+    return !row.ticketId.empty() && Iso8601::parse(creationDate, row.creationTime) &&
+           parseInt(validity, row.validityDays) && parseInt(lineNumber, row.lineNumber);
+}
+
+void TicketCsv::writeFile(const std::string& path, const std::vector<Ticket>& tickets) {
+    std::ofstream file(path, std::ios::trunc);
+    file << kHeader << "\n";
+
+    for (const auto& ticket : tickets) {
+        file << formatRow(ticket) << "\n";
+    }
+
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Failed to write " + path);
+    }
+}
@@ -0,0 +1,74 @@
+// src/backoffice/ticket_index.cpp
+#include "ticket_index.h"
+
+namespace {
+
+constexpr size_t kMinSlots = 16;
+
+} // namespace
+
+TicketIndex::TicketIndex(size_t expectedTickets)
+    : slots_(slotsFor(expectedTickets), Slot{0, kNotFound}),
+      mask_(slots_.size() - 1),
+      size_(0) {
+}
+
+uint64_t TicketIndex::hash(std::string_view id) {
+    uint64_t h = 14695981039346656037ULL;
+    for (unsigned char c : id) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+
+    // FNV-1a leaves the low bits poorly mixed for short, similar keys
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+void TicketIndex::reserve(size_t expectedTickets) {
+    size_t slotCount = slotsFor(expectedTickets);
+    if (slotCount > slots_.size()) {
+        rehash(slotCount);
+    }
+}
+
+void TicketIndex::insertUnique(uint64_t idHash, uint32_t position) {
+    if ((size_ + 1) * 10 > slots_.size() * 7) {
+        rehash(slots_.size() * 2);
+    }
+
+    size_t i = idHash & mask_;
+    while (slots_[i].position != kNotFound) {
+        i = (i + 1) & mask_;
+    }
+    slots_[i] = Slot{idHash, position};
+    size_++;
+}
+
+void TicketIndex::rehash(size_t slotCount) {
+    std::vector<Slot> old(slotCount, Slot{0, kNotFound});
+    old.swap(slots_);
+    mask_ = slots_.size() - 1;
+
+    for (const Slot& slot : old) {
+        if (slot.position == kNotFound) continue;
+        size_t i = slot.hash & mask_;
+        while (slots_[i].position != kNotFound) {
+            i = (i + 1) & mask_;
+        }
+        slots_[i] = slot;
+    }
+}
+
+// Smallest power of two keeping the table at most 70% full
+size_t TicketIndex::slotsFor(size_t tickets) {
+    size_t slots = kMinSlots;
+    while (slots * 7 < tickets * 10) {
+        slots *= 2;
+    }
+    return slots;
+}
@@ -0,0 +1,343 @@
+// src/backoffice/ticket_journal.cpp
+#include "ticket_journal.h"
+#include <iostream>
+#include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+namespace {
+
+std::string errnoMessage(const std::string& what, const std::string& path) {
+    return what + " " + path + ": " + std::strerror(errno);
+}
+
+bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+} // namespace
+
+TicketJournal::TicketJournal(const std::string& snapshotPath, SnapshotWriter snapshotWriter,
+                             size_t compactionThreshold)
+    : snapshotPath_(snapshotPath),
+      journalPath_(snapshotPath + ".journal"),
+      rotatedPath_(snapshotPath + ".journal.old"),
+      snapshotWriter_(std::move(snapshotWriter)),
+      compactionThreshold_(compactionThreshold),
+      fd_(-1),
+      pendingRecords_(0),
+      appendedBatches_(0),
+      durableBatches_(0),
+      recordsSinceCompaction_(0),
+      rotateRequested_(false),
+      rotateDone_(false),
+      rotatedBatches_(0),
+      running_(false) {
+}
+
+TicketJournal::~TicketJournal() {
+    close();
+}
+
+std::vector<std::string> TicketJournal::replayPaths() const {
+    std::vector<std::string> paths;
+    if (fileExists(rotatedPath_)) paths.push_back(rotatedPath_);
+    if (fileExists(journalPath_)) paths.push_back(journalPath_);
+    return paths;
+}
+
+void TicketJournal::open() {
+    std::lock_guard<std::mutex> compactLock(compactMutex_);
+    if (running_) return;
+
+    // A compaction was interrupted: the loaded store already covers the
+    // rotated journal, so finish it before accepting new sales.
+    if (fileExists(rotatedPath_)) {
+        writeSnapshot();
+        if (std::remove(rotatedPath_.c_str()) != 0) {
+            throw std::runtime_error(errnoMessage("Failed to remove", rotatedPath_));
+        }
+        syncParentDirectory(rotatedPath_);
+    }
+
+    openJournalFile();
+
+    running_ = true;
+    flusher_ = std::thread(&TicketJournal::flushLoop, this);
+    compactor_ = std::thread(&TicketJournal::compactLoop, this);
+}
+
+void TicketJournal::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) return;
+        running_ = false;
+    }
+    flushCv_.notify_all();
+    compactCv_.notify_all();
+
+    if (compactor_.joinable()) compactor_.join();
+    if (flusher_.joinable()) flusher_.join();
+
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+void TicketJournal::append(const std::string& row) {
+    append(std::vector<std::string>{row});
+}
+
+void TicketJournal::append(const std::vector<std::string>& rows) {
+    append(rows, nullptr);
+}
+
+void TicketJournal::append(const std::vector<std::string>& rows, const Apply& apply) {
+    if (rows.empty()) return;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!running_) {
+        throw std::runtime_error("Ticket journal is not open");
+    }
+    if (!writeError_.empty()) {
+        throw std::runtime_error("Ticket journal unavailable: " + writeError_);
+    }
+
+    for (const auto& row : rows) {
+        pending_ += row;
+        pending_ += '\n';
+    }
+    pendingRecords_ += rows.size();
+    uint64_t batch = ++appendedBatches_;
+    if (apply) applying_.insert(batch);
+    flushCv_.notify_one();
+
+    auto applied = [&] {
+        applying_.erase(batch);
+        appliedCv_.notify_all();
+    };
+
+    durableCv_.wait(lock, [&] { return durableBatches_ >= batch || !writeError_.empty(); });
+    if (durableBatches_ < batch) {
+        applied();
+        throw std::runtime_error("Ticket journal write failed: " + writeError_);
+    }
+    if (!apply) return;
+
+    lock.unlock();
+    try {
+        apply();
+    } catch (...) {
+        lock.lock();
+        applied();
+        throw;
+    }
+    lock.lock();
+    applied();
+}
+
+void TicketJournal::compact() {
+    std::lock_guard<std::mutex> compactLock(compactMutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        recordsSinceCompaction_ = 0;
+    }
+
+    requestRotation();
+    {
+        // Rows in the rotated journal must be in the store before it is
+        // snapshotted; later rows went to the new journal
+        std::unique_lock<std::mutex> lock(mutex_);
+        appliedCv_.wait(lock, [&] { return applying_.empty() || *applying_.begin() > rotatedBatches_; });
+    }
+    writeSnapshot();
+
+    if (std::remove(rotatedPath_.c_str()) != 0 && errno != ENOENT) {
+        throw std::runtime_error(errnoMessage("Failed to remove", rotatedPath_));
+    }
+    syncParentDirectory(rotatedPath_);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.compactions++;
+}
+
+TicketJournal::Stats TicketJournal::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+// Group commit: every row queued while the previous batch was being
+// written goes out with a single write + fdatasync.
+void TicketJournal::flushLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        flushCv_.wait(lock, [&] {
+            return !running_ || !pending_.empty() || (rotateRequested_ && !rotateDone_);
+        });
+
+        if (!pending_.empty()) {
+            std::string batch;
+            batch.swap(pending_);
+            size_t records = pendingRecords_;
+            uint64_t upTo = appendedBatches_;
+            pendingRecords_ = 0;
+
+            lock.unlock();
+            bool ok = writeAll(fd_, batch.data(), batch.size()) && ::fdatasync(fd_) == 0;
+            std::string error = ok ? "" : errnoMessage("Failed to write", journalPath_);
+            lock.lock();
+
+            if (ok) {
+                durableBatches_ = upTo;
+                stats_.records += records;
+                stats_.flushes++;
+                recordsSinceCompaction_ += records;
+                if (recordsSinceCompaction_ >= compactionThreshold_) {
+                    compactCv_.notify_one();
+                }
+            } else {
+                writeError_ = error;
+                std::cerr << "✗ Journal error: " << error << std::endl;
+            }
+            durableCv_.notify_all();
+        }
+
+        if (rotateRequested_ && !rotateDone_) {
+            // Every batch written so far is in the file being rotated out
+            rotatedBatches_ = durableBatches_;
+            lock.unlock();
+            rotateFiles();
+            lock.lock();
+            rotateDone_ = true;
+            durableCv_.notify_all();
+        }
+
+        if (!running_ && pending_.empty()) break;
+    }
+}
+
+void TicketJournal::compactLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        compactCv_.wait(lock, [&] {
+            return !running_ || recordsSinceCompaction_ >= compactionThreshold_;
+        });
+        if (!running_) break;
+
+        lock.unlock();
+        try {
+            std::cout << "Compacting ticket journal into " << snapshotPath_ << "..." << std::endl;
+            compact();
+            std::cout << "✓ Journal compacted" << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << "⚠ Journal compaction failed: " << e.what() << std::endl;
+        }
+        lock.lock();
+    }
+}
+
+// Ask the flusher to switch files between two batches and wait for it
+void TicketJournal::requestRotation() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!running_) return;
+
+    rotateRequested_ = true;
+    rotateDone_ = false;
+    flushCv_.notify_one();
+    durableCv_.wait(lock, [&] { return rotateDone_ || !running_; });
+    rotateRequested_ = false;
+}
+
+// Runs on the flusher thread, which owns fd_
+void TicketJournal::rotateFiles() {
+    // A previous compaction failed after rotating: keep appending to the
+    // current journal, the next snapshot covers the rotated one as well.
+    if (fileExists(rotatedPath_)) return;
+
+    ::close(fd_);
+    fd_ = -1;
+    if (std::rename(journalPath_.c_str(), rotatedPath_.c_str()) != 0) {
+        std::cerr << "⚠ " << errnoMessage("Failed to rotate", journalPath_) << std::endl;
+    }
+
+    try {
+        openJournalFile();
+    } catch (const std::exception& e) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        writeError_ = e.what();
+        std::cerr << "✗ Journal error: " << e.what() << std::endl;
+    }
+}
+
+void TicketJournal::writeSnapshot() {
+    std::string tmpPath = snapshotPath_ + ".tmp";
+    snapshotWriter_(tmpPath);
+
+    int fd = ::open(tmpPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error(errnoMessage("Failed to open", tmpPath));
+    }
+    int rc = ::fsync(fd);
+    ::close(fd);
+    if (rc != 0) {
+        throw std::runtime_error(errnoMessage("Failed to sync", tmpPath));
+    }
+
+    if (std::rename(tmpPath.c_str(), snapshotPath_.c_str()) != 0) {
+        throw std::runtime_error(errnoMessage("Failed to replace", snapshotPath_));
+    }
+    syncParentDirectory(snapshotPath_);
+}
+
+void TicketJournal::openJournalFile() {
+    int fd = ::open(journalPath_.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error(errnoMessage("Failed to open", journalPath_));
+    }
+
+    // Terminate a row torn by a crash so the next append starts a new line
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+        char last = '\n';
+        if (::pread(fd, &last, 1, st.st_size - 1) == 1 && last != '\n') {
+            if (!writeAll(fd, "\n", 1)) {
+                ::close(fd);
+                throw std::runtime_error(errnoMessage("Failed to repair", journalPath_));
+            }
+        }
+    }
+
+    fd_ = fd;
+}
+
+bool TicketJournal::fileExists(const std::string& path) {
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0;
+}
+
+void TicketJournal::syncParentDirectory(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    std::string dir = slash == std::string::npos ? "." : path.substr(0, slash + 1);
+
+    int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+}
@@ -0,0 +1,235 @@
+// src/backoffice/ticket_snapshot.cpp
+#include "ticket_snapshot.h"
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+const char TicketSnapshot::kMagic[8] = {'T', 'K', 'T', 'S', 'N', 'A', 'P', '\0'};
+
+namespace {
+
+std::string_view fieldView(const char* field, size_t width) {
+    return std::string_view(field, strnlen(field, width));
+}
+
+template <typename Fn>
+void runParallel(size_t count, Fn&& fn) {
+    std::vector<std::thread> threads;
+    threads.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        threads.emplace_back(fn, i);
+    }
+    for (auto& thread : threads) thread.join();
+}
+
+// Below this many records per thread, bucketing is not worth a thread
+constexpr size_t kMinRecordsPerThread = 4096;
+
+// IDs that fill the ID field without a terminator are still kept inline
+constexpr size_t kInlineIdLength = sizeof(TicketSnapshotRecord::ticketId);
+
+} // namespace
+
+TicketSnapshot::TicketSnapshot(const std::string& path)
+    : mapping_(nullptr), mappingSize_(0), records_(nullptr), count_(0), longIds_(nullptr), longIdBytes_(0) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open " + path + ": " + std::strerror(errno));
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(TicketSnapshotHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Snapshot too short: " + path);
+    }
+
+    mappingSize_ = static_cast<size_t>(st.st_size);
+    mapping_ = ::mmap(nullptr, mappingSize_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping_ == MAP_FAILED) {
+        mapping_ = nullptr;
+        throw std::runtime_error("Failed to map " + path + ": " + std::strerror(errno));
+    }
+
+    const auto* header = static_cast<const TicketSnapshotHeader*>(mapping_);
+    std::string error;
+    if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0) {
+        error = "not a ticket snapshot";
+    } else if (header->version != kVersion) {
+        error = "unsupported snapshot version " + std::to_string(header->version);
+    } else if (header->recordSize != sizeof(TicketSnapshotRecord)) {
+        error = "unexpected record size " + std::to_string(header->recordSize);
+    } else if (header->recordCount > (mappingSize_ - sizeof(TicketSnapshotHeader)) / sizeof(TicketSnapshotRecord) ||
+               header->longIdBytes > mappingSize_ - sizeof(TicketSnapshotHeader) -
+                                     header->recordCount * sizeof(TicketSnapshotRecord)) {
+        error = "truncated snapshot";
+    }
+
+    if (!error.empty()) {
+        ::munmap(mapping_, mappingSize_);
+        mapping_ = nullptr;
+        throw std::runtime_error("Invalid snapshot " + path + ": " + error);
+    }
+
+    count_ = static_cast<size_t>(header->recordCount);
+    records_ = static_cast<const char*>(mapping_) + sizeof(TicketSnapshotHeader);
+    longIds_ = records_ + count_ * sizeof(TicketSnapshotRecord);
+    longIdBytes_ = static_cast<size_t>(header->longIdBytes);
+
+    // Loading reads every record once, front to back
+    ::madvise(mapping_, mappingSize_, MADV_SEQUENTIAL);
+}
+
+TicketSnapshot::~TicketSnapshot() {
+    if (mapping_) {
+        ::munmap(mapping_, mappingSize_);
+    }
+}
+
+bool TicketSnapshot::idOf(const TicketSnapshotRecord& record, std::string_view& ticketId) const {
+    if (record.longIdLength == 0) {
+        ticketId = fieldView(record.ticketId, sizeof(record.ticketId));
+        return true;
+    }
+    if (record.longIdLength > longIdBytes_ || record.longIdOffset > longIdBytes_ - record.longIdLength) {
+        return false;
+    }
+    ticketId = std::string_view(longIds_ + record.longIdOffset, record.longIdLength);
+    return true;
+}
+
+Ticket TicketSnapshot::ticket(size_t i) const {
+    const auto& r = *reinterpret_cast<const TicketSnapshotRecord*>(records_ + i * sizeof(TicketSnapshotRecord));
+    std::string_view id;
+    if (!idOf(r, id)) {
+        throw std::runtime_error("Snapshot record " + std::to_string(i) + " has an invalid long ID");
+    }
+    return Ticket(std::string(id), r.creationTime, r.validityDays, r.lineNumber);
+}
+
+bool TicketSnapshot::record(size_t i, TicketRecord& record, std::string_view& ticketId) const {
+    const auto& r = *reinterpret_cast<const TicketSnapshotRecord*>(records_ + i * sizeof(TicketSnapshotRecord));
+    record.creationTime = r.creationTime;
+    record.validityDays = r.validityDays;
+    record.lineNumber = r.lineNumber;
+    return idOf(r, ticketId);
+}
+
+size_t TicketSnapshot::loadInto(TicketStore& store, size_t threadCount) const {
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    size_t shardCount = store.shardCount();
+    size_t chunks = std::max<size_t>(1, std::min(threadCount, count_ / kMinRecordsPerThread));
+
+    // buckets[chunk][shard]; IDs point into the mapping
+    struct Bucket {
+        std::vector<TicketRecord> records;
+        std::vector<std::string_view> ids;
+    };
+    std::vector<std::vector<Bucket>> buckets(chunks);
+    std::atomic<size_t> badRecords{0};
+
+    runParallel(chunks, [&](size_t c) {
+        buckets[c].resize(shardCount);
+        size_t begin = count_ * c / chunks;
+        size_t end = count_ * (c + 1) / chunks;
+        TicketRecord fields;
+        std::string_view id;
+        for (size_t i = begin; i < end; i++) {
+            if (!record(i, fields, id)) {
+                badRecords.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            Bucket& bucket = buckets[c][store.shardIndex(id)];
+            bucket.records.push_back(fields);
+            bucket.ids.push_back(id);
+        }
+    });
+    if (badRecords.load() > 0) {
+        throw std::runtime_error("Invalid long ID in " + std::to_string(badRecords.load()) + " snapshot records");
+    }
+
+    store.reserve(store.size() + count_);
+
+    // Each merge thread owns every shard congruent to its index; chunks are
+    // merged in file order so the first copy of a duplicated ID wins
+    size_t mergeThreads = std::min(threadCount, shardCount);
+    std::vector<size_t> inserted(mergeThreads, 0);
+    runParallel(mergeThreads, [&](size_t t) {
+        for (size_t shard = t; shard < shardCount; shard += mergeThreads) {
+            for (auto& chunkBuckets : buckets) {
+                Bucket& bucket = chunkBuckets[shard];
+                inserted[t] += store.insertIntoShard(shard, bucket.records, bucket.ids);
+                std::vector<TicketRecord>().swap(bucket.records);
+                std::vector<std::string_view>().swap(bucket.ids);
+            }
+        }
+    });
+
+    size_t total = 0;
+    for (size_t count : inserted) total += count;
+    return total;
+}
+
+bool TicketSnapshot::isSnapshotFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(kMagic)] = {};
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+bool TicketSnapshot::isSnapshotPath(const std::string& path) {
+    return path.size() >= 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+}
+
+void TicketSnapshot::write(const std::string& path, const std::vector<Ticket>& tickets) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+    TicketSnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.recordSize = sizeof(TicketSnapshotRecord);
+    header.recordCount = tickets.size();
+    for (const auto& ticket : tickets) {
+        if (ticket.getId().size() > kInlineIdLength) header.longIdBytes += ticket.getId().size();
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // Legacy IDs may be longer than the record field (up to
+    // TicketStore::kMaxLegacyIdLength); those go to the long ID area
+    TicketSnapshotRecord record;
+    std::memset(&record, 0, sizeof(record));
+    uint64_t longIdOffset = 0;
+    for (const auto& ticket : tickets) {
+        const std::string& id = ticket.getId();
+        std::memset(record.ticketId, 0, sizeof(record.ticketId));
+        record.longIdLength = 0;
+        record.longIdOffset = 0;
+        if (id.size() > kInlineIdLength) {
+            record.longIdLength = static_cast<uint32_t>(id.size());
+            record.longIdOffset = longIdOffset;
+            longIdOffset += id.size();
+        } else {
+            std::memcpy(record.ticketId, id.data(), id.size());
+        }
+        record.creationTime = ticket.getCreationTime();
+        record.validityDays = ticket.getValidityDays();
+        record.lineNumber = ticket.getLineNumber();
+        file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    }
+    for (const auto& ticket : tickets) {
+        if (ticket.getId().size() > kInlineIdLength) file.write(ticket.getId().data(), ticket.getId().size());
+    }
+
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Failed to write " + path);
+    }
+}
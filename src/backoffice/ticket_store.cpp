@@ -0,0 +1,263 @@
+// src/backoffice/ticket_store.cpp
+#include "ticket_store.h"
+#include <algorithm>
+#include <utility>
+
+TicketStore::TicketStore(size_t shardCount)
+    : shardMask_(0),
+      size_(0) {
+    size_t count = 1;
+    while (count < shardCount) {
+        count *= 2;
+    }
+
+    shards_.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        shards_.push_back(std::make_unique<Shard>());
+    }
+    shardMask_ = count - 1;
+}
+
+bool TicketStore::insert(const Ticket& ticket) {
+    Key key = keyOf(ticket.getId());
+    Shard& shard = shardFor(key.hash);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+    if (!insertLocked(shard, key, fieldsOf(ticket))) {
+        return false;
+    }
+    size_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+size_t TicketStore::insertMany(const std::vector<Ticket>& tickets) {
+    // Visit tickets grouped by shard so each shard lock is taken once
+    struct Pending {
+        size_t shard;
+        size_t position;
+        Key key;
+        bool operator<(const Pending& other) const {
+            return shard != other.shard ? shard < other.shard : position < other.position;
+        }
+    };
+
+    std::vector<Pending> order;
+    order.reserve(tickets.size());
+    for (size_t i = 0; i < tickets.size(); i++) {
+        Key key = keyOf(tickets[i].getId());
+        order.push_back({(key.hash >> 40) & shardMask_, i, key});
+    }
+    std::sort(order.begin(), order.end());
+
+    size_t inserted = 0;
+    for (size_t i = 0; i < order.size();) {
+        Shard& shard = *shards_[order[i].shard];
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+        size_t group = order[i].shard;
+        for (; i < order.size() && order[i].shard == group; i++) {
+            if (insertLocked(shard, order[i].key, fieldsOf(tickets[order[i].position]))) inserted++;
+        }
+    }
+    size_.fetch_add(inserted, std::memory_order_relaxed);
+    return inserted;
+}
+
+size_t TicketStore::insertIntoShard(size_t shardIndex, const std::vector<TicketCsv::Row>& rows) {
+    Shard& shard = *shards_[shardIndex & shardMask_];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+    size_t inserted = 0;
+    for (const auto& row : rows) {
+        TicketRecord fields;
+        fields.creationTime = row.creationTime;
+        fields.validityDays = row.validityDays;
+        fields.lineNumber = row.lineNumber;
+        if (insertLocked(shard, keyOf(row.ticketId), fields)) inserted++;
+    }
+    size_.fetch_add(inserted, std::memory_order_relaxed);
+    return inserted;
+}
+
+size_t TicketStore::insertIntoShard(size_t shardIndex, const std::vector<TicketRecord>& records,
+                                    const std::vector<std::string_view>& ids) {
+    Shard& shard = *shards_[shardIndex & shardMask_];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+    size_t inserted = 0;
+    for (size_t i = 0; i < records.size(); i++) {
+        if (insertLocked(shard, keyOf(ids[i]), records[i])) inserted++;
+    }
+    size_.fetch_add(inserted, std::memory_order_relaxed);
+    return inserted;
+}
+
+uint32_t TicketStore::findLocked(const Shard& shard, const Key& key) {
+    // Snowflake IDs compare as integers, only legacy IDs touch the side table
+    return shard.index.findMatching(key.hash, [&](uint32_t position) {
+        const TicketRecord& record = shard.records[position];
+        if (key.packed != TicketRecord::kLegacyId) return record.id == key.packed;
+        return record.hasLegacyId() && shard.legacyId(record) == key.text;
+    });
+}
+
+bool TicketStore::insertLocked(Shard& shard, const Key& key, TicketRecord record) {
+    bool legacy = key.packed == TicketRecord::kLegacyId;
+    if (legacy && key.text.size() > kMaxLegacyIdLength) {
+        return false;
+    }
+    if (findLocked(shard, key) != TicketIndex::kNotFound) {
+        return false;
+    }
+
+    record.id = key.packed;
+    if (legacy) {
+        record.id |= static_cast<uint64_t>(shard.legacyIds.size()) << 16 | key.text.size();
+        shard.legacyIds.append(key.text);
+    }
+
+    uint32_t position = static_cast<uint32_t>(shard.records.size());
+    shard.records.push_back(record);
+    shard.index.insertUnique(key.hash, position);
+    return true;
+}
+
+TicketRecord TicketStore::fieldsOf(const Ticket& ticket) {
+    TicketRecord record;
+    record.creationTime = ticket.getCreationTime();
+    record.validityDays = ticket.getValidityDays();
+    record.lineNumber = ticket.getLineNumber();
+    return record;
+}
+
+bool TicketStore::contains(std::string_view ticketId) const {
+    Key key = keyOf(ticketId);
+    const Shard& shard = shardFor(key.hash);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+    return findLocked(shard, key) != TicketIndex::kNotFound;
+}
+
+std::vector<bool> TicketStore::findMany(const std::vector<std::string_view>& ticketIds,
+                                        std::vector<TicketRecord>& records) const {
+    struct Lookup {
+        size_t shard;
+        size_t position;
+        Key key;
+        bool operator<(const Lookup& other) const { return shard < other.shard; }
+    };
+
+    std::vector<Lookup> order;
+    order.reserve(ticketIds.size());
+    for (size_t i = 0; i < ticketIds.size(); i++) {
+        Key key = keyOf(ticketIds[i]);
+        order.push_back({(key.hash >> 40) & shardMask_, i, key});
+    }
+    std::sort(order.begin(), order.end());
+
+    std::vector<bool> found(ticketIds.size(), false);
+    records.assign(ticketIds.size(), TicketRecord());
+    for (size_t i = 0; i < order.size();) {
+        const Shard& shard = *shards_[order[i].shard];
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+        size_t group = order[i].shard;
+        for (; i < order.size() && order[i].shard == group; i++) {
+            uint32_t position = findLocked(shard, order[i].key);
+            if (position != TicketIndex::kNotFound) {
+                found[order[i].position] = true;
+                records[order[i].position] = shard.records[position];
+            }
+        }
+    }
+    return found;
+}
+
+bool TicketStore::find(std::string_view ticketId, Ticket& ticket) const {
+    Key key = keyOf(ticketId);
+    const Shard& shard = shardFor(key.hash);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+    uint32_t position = findLocked(shard, key);
+    if (position == TicketIndex::kNotFound) {
+        return false;
+    }
+    const TicketRecord& record = shard.records[position];
+    ticket.assign(record, shard.legacyId(record));
+    return true;
+}
+
+bool TicketStore::find(std::string_view ticketId, TicketRecord& record) const {
+    Key key = keyOf(ticketId);
+    const Shard& shard = shardFor(key.hash);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+    uint32_t position = findLocked(shard, key);
+    if (position == TicketIndex::kNotFound) {
+        return false;
+    }
+    record = shard.records[position];
+    return true;
+}
+
+void TicketStore::reserve(size_t expectedTickets) {
+    // Leave headroom for an uneven hash spread
+    size_t perShard = expectedTickets / shards_.size() + expectedTickets / (shards_.size() * 8) + 1;
+
+    for (auto& shard : shards_) {
+        std::unique_lock<std::shared_mutex> lock(shard->mutex);
+        shard->records.reserve(perShard);
+        shard->index.reserve(perShard);
+    }
+}
+
+std::vector<Ticket> TicketStore::snapshot() const {
+    std::vector<Ticket> tickets;
+    tickets.reserve(size());
+
+    for (const auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard->mutex);
+        for (const auto& record : shard->records) {
+            tickets.push_back(Ticket::fromRecord(record, shard->legacyId(record)));
+        }
+    }
+    return tickets;
+}
+
+std::vector<size_t> TicketStore::shardSizes() const {
+    std::vector<size_t> sizes;
+    sizes.reserve(shards_.size());
+
+    for (const auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard->mutex);
+        sizes.push_back(shard->records.size());
+    }
+    return sizes;
+}
+
+size_t TicketStore::copyPage(Cursor& cursor, const std::vector<size_t>& bounds, size_t limit,
+                             std::vector<Ticket>& out) const {
+    size_t copied = 0;
+
+    while (copied < limit && cursor.shard < shards_.size()) {
+        size_t end = cursor.shard < bounds.size() ? bounds[cursor.shard] : 0;
+        if (cursor.offset >= end) {
+            cursor.shard++;
+            cursor.offset = 0;
+            continue;
+        }
+
+        size_t count = std::min(end - cursor.offset, limit - copied);
+        {
+            const Shard& shard = *shards_[cursor.shard];
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            for (size_t i = cursor.offset; i < cursor.offset + count; i++) {
+                const TicketRecord& record = shard.records[i];
+                out.push_back(Ticket::fromRecord(record, shard.legacyId(record)));
+            }
+        }
+        cursor.offset += count;
+        copied += count;
+    }
+    return copied;
+}
@@ -0,0 +1,56 @@
+// src/backoffice/ticket_validator.cpp
+#include "ticket_validator.h"
+#include <string_view>
+
+TicketValidator::TicketValidator(const TicketStore& store) : store_(store) {
+}
+
+TicketValidator::Verdict TicketValidator::check(const Ticket& ticket, TicketSigner::Status signature) const {
+    return check(ticket, signature, Ticket::currentTime());
+}
+
+TicketValidator::Verdict TicketValidator::check(const Ticket& ticket, TicketSigner::Status signature,
+                                                int64_t now) const {
+    TicketRecord stored;
+    bool found = store_.find(ticket.getId(), stored);
+    return verdict(ticket, signature, found ? &stored : nullptr, now);
+}
+
+std::vector<TicketValidator::Verdict> TicketValidator::checkMany(
+    const std::vector<const Ticket*>& tickets, const std::vector<TicketSigner::Status>& signatures) const {
+    std::vector<std::string_view> ids;
+    ids.reserve(tickets.size());
+    for (const Ticket* ticket : tickets) {
+        ids.push_back(ticket->getId());
+    }
+
+    std::vector<TicketRecord> records;
+    std::vector<bool> found = store_.findMany(ids, records);
+
+    int64_t now = Ticket::currentTime();
+    std::vector<Verdict> verdicts;
+    verdicts.reserve(tickets.size());
+    for (size_t i = 0; i < tickets.size(); i++) {
+        verdicts.push_back(verdict(*tickets[i], signatures[i], found[i] ? &records[i] : nullptr, now));
+    }
+    return verdicts;
+}
+
+TicketValidator::Verdict TicketValidator::verdict(const Ticket& ticket, TicketSigner::Status signature,
+                                                  const TicketRecord* stored, int64_t now) {
+    if (signature == TicketSigner::Status::BadSignature ||
+        signature == TicketSigner::Status::UnknownKey) {
+        return {false, "Invalid ticket signature"};
+    }
+    if (!stored) return {false, "Ticket not found in database"};
+
+    // Expiry and line come from the record, never from the presented fields
+    if (ticket.getCreationTime() != stored->creationTime ||
+        ticket.getValidityDays() != stored->validityDays ||
+        ticket.getLineNumber() != stored->lineNumber) {
+        return {false, "Ticket data does not match records"};
+    }
+    if (stored->isExpiredAt(now)) return {false, "Ticket expired"};
+
+    return {true, "Ticket is valid"};
+}
@@ -0,0 +1,388 @@
+// src/common/base64.cpp
+#include "base64.h"
+#include <atomic>
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BASE64_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using Variant = Base64::Variant;
+using Isa = Base64::Isa;
+
+constexpr char kStandardAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr char kUrlAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+struct DecodeTable {
+    int8_t values[256];
+};
+
+constexpr DecodeTable makeDecodeTable(const char* alphabet) {
+    DecodeTable table{};
+    for (int i = 0; i < 256; i++) {
+        table.values[i] = -1;
+    }
+    for (int i = 0; i < 64; i++) {
+        table.values[static_cast<unsigned char>(alphabet[i])] = static_cast<int8_t>(i);
+    }
+    return table;
+}
+
+constexpr DecodeTable kStandardDecode = makeDecodeTable(kStandardAlphabet);
+constexpr DecodeTable kUrlDecode = makeDecodeTable(kUrlAlphabet);
+
+static_assert(kStandardDecode.values['+'] == 62 && kStandardDecode.values['/'] == 63, "standard table");
+static_assert(kUrlDecode.values['-'] == 62 && kUrlDecode.values['_'] == 63, "URL-safe table");
+static_assert(kStandardDecode.values['='] == -1, "padding is not part of the alphabet");
+
+// ============================================================================
+// SCALAR CODEC
+// ============================================================================
+
+size_t encodeScalar(const uint8_t* in, size_t size, char* out, Variant variant) {
+    const char* alphabet = variant == Variant::Standard ? kStandardAlphabet : kUrlAlphabet;
+    char* start = out;
+
+    size_t i = 0;
+    for (; i + 3 <= size; i += 3) {
+        uint32_t v = (uint32_t{in[i]} << 16) | (uint32_t{in[i + 1]} << 8) | in[i + 2];
+        out[0] = alphabet[(v >> 18) & 0x3F];
+        out[1] = alphabet[(v >> 12) & 0x3F];
+        out[2] = alphabet[(v >> 6) & 0x3F];
+        out[3] = alphabet[v & 0x3F];
+        out += 4;
+    }
+
+    size_t rest = size - i;
+    if (rest > 0) {
+        uint32_t v = uint32_t{in[i]} << 16;
+        if (rest == 2) v |= uint32_t{in[i + 1]} << 8;
+
+        *out++ = alphabet[(v >> 18) & 0x3F];
+        *out++ = alphabet[(v >> 12) & 0x3F];
+        if (rest == 2) {
+            *out++ = alphabet[(v >> 6) & 0x3F];
+        }
+        if (variant == Variant::Standard) {
+            *out++ = '=';
+            if (rest == 1) *out++ = '=';
+        }
+    }
+    return static_cast<size_t>(out - start);
+}
+
+// Decodes unpadded text; returns the bytes written or npos
+size_t decodeScalar(const char* in, size_t length, uint8_t* out, const DecodeTable& table) {
+    if (length % 4 == 1) return Base64::npos;
+
+    auto value = [&table](char c) { return table.values[static_cast<unsigned char>(c)]; };
+    uint8_t* start = out;
+
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4) {
+        int a = value(in[i]), b = value(in[i + 1]), c = value(in[i + 2]), d = value(in[i + 3]);
+        if ((a | b | c | d) < 0) return Base64::npos;
+
+        uint32_t v = (uint32_t(a) << 18) | (uint32_t(b) << 12) | (uint32_t(c) << 6) | uint32_t(d);
+        out[0] = static_cast<uint8_t>(v >> 16);
+        out[1] = static_cast<uint8_t>(v >> 8);
+        out[2] = static_cast<uint8_t>(v);
+        out += 3;
+    }
+
+    size_t rest = length - i;
+    if (rest > 0) {
+        int a = value(in[i]), b = value(in[i + 1]);
+        int c = rest == 3 ? value(in[i + 2]) : 0;
+        if ((a | b | c) < 0) return Base64::npos;
+
+        uint32_t v = (uint32_t(a) << 18) | (uint32_t(b) << 12) | (uint32_t(c) << 6);
+        *out++ = static_cast<uint8_t>(v >> 16);
+        if (rest == 3) *out++ = static_cast<uint8_t>(v >> 8);
+    }
+    return static_cast<size_t>(out - start);
+}
+
+// ============================================================================
+// SIMD KERNELS (x86)
+//
+// Encoding follows Muła's pshufb/multiply split of 3 bytes into four 6-bit
+// indices; decoding uses the nibble lookup from Klomp's base64 library,
+// which validates and translates 16 characters at once. Kernels stop
+// before the last bytes and on the first block with a non-alphabet
+// character; the scalar code handles the rest (and reports the error).
+// ============================================================================
+
+#ifdef BASE64_X86
+
+__attribute__((target("ssse3")))
+size_t encodeSsse3(const uint8_t* in, size_t size, char* out, Variant variant) {
+    const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m128i offsets = variant == Variant::Standard
+        ? _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0)
+        : _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -17, 32, 0, 0);
+
+    size_t consumed = 0;
+    // Each 16-byte load uses 12 bytes
+    while (size - consumed >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + consumed));
+        v = _mm_shuffle_epi8(v, shuffle);
+
+        __m128i ac = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+        __m128i bd = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+        __m128i indices = _mm_or_si128(ac, bd);
+
+        __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        range = _mm_sub_epi8(range, _mm_cmpgt_epi8(indices, _mm_set1_epi8(25)));
+        __m128i ascii = _mm_add_epi8(indices, _mm_shuffle_epi8(offsets, range));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), ascii);
+        consumed += 12;
+        out += 16;
+    }
+    return consumed;
+}
+
+__attribute__((target("avx2")))
+size_t encodeAvx2(const uint8_t* in, size_t size, char* out, Variant variant) {
+    const __m256i shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                             1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i offsets = variant == Variant::Standard
+        ? _mm256_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0,
+                           65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0)
+        : _mm256_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -17, 32, 0, 0,
+                           65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -17, 32, 0, 0);
+
+    size_t consumed = 0;
+    // Two 16-byte loads, 12 bytes used from each
+    while (size - consumed >= 28) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + consumed));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + consumed + 12));
+        __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        v = _mm256_shuffle_epi8(v, shuffle);
+
+        __m256i ac = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00)),
+                                        _mm256_set1_epi32(0x04000040));
+        __m256i bd = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0)),
+                                        _mm256_set1_epi32(0x01000010));
+        __m256i indices = _mm256_or_si256(ac, bd);
+
+        __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        range = _mm256_sub_epi8(range, _mm256_cmpgt_epi8(indices, _mm256_set1_epi8(25)));
+        __m256i ascii = _mm256_add_epi8(indices, _mm256_shuffle_epi8(offsets, range));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), ascii);
+        consumed += 24;
+        out += 32;
+    }
+    return consumed;
+}
+
+// Standard alphabet only. Returns the number of characters consumed.
+__attribute__((target("ssse3")))
+size_t decodeSsse3(const char* in, size_t length, uint8_t* out) {
+    const __m128i lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask2F = _mm_set1_epi8(0x2F);
+    const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+    size_t consumed = 0;
+    // Each store writes 16 bytes of which 12 are output; keep enough input
+    // left that the extra 4 land inside the caller's buffer
+    while (length - consumed >= 24) {
+        __m128i str = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + consumed));
+
+        __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(str, 4), mask2F);
+        __m128i loNibbles = _mm_and_si128(str, mask2F);
+        __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+        __m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+        if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0) {
+            break;
+        }
+
+        __m128i eq2F = _mm_cmpeq_epi8(str, mask2F);
+        __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(eq2F, hiNibbles));
+        str = _mm_add_epi8(str, roll);
+
+        __m128i merged = _mm_maddubs_epi16(str, _mm_set1_epi32(0x01400140));
+        __m128i words = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(words, pack));
+
+        consumed += 16;
+        out += 12;
+    }
+    return consumed;
+}
+
+__attribute__((target("avx2")))
+size_t decodeAvx2(const char* in, size_t length, uint8_t* out) {
+    const __m256i lutLo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                           0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                           0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                           0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lutHi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                           0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                           0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                           0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lutRoll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                             0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i mask2F = _mm256_set1_epi8(0x2F);
+    const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+
+    size_t consumed = 0;
+    // 32 characters -> 24 bytes, stored as 32
+    while (length - consumed >= 48) {
+        __m256i str = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + consumed));
+
+        __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(str, 4), mask2F);
+        __m256i loNibbles = _mm256_and_si256(str, mask2F);
+        __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+        __m256i lo = _mm256_shuffle_epi8(lutLo, loNibbles);
+        if (_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256())) != 0) {
+            break;
+        }
+
+        __m256i eq2F = _mm256_cmpeq_epi8(str, mask2F);
+        __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(eq2F, hiNibbles));
+        str = _mm256_add_epi8(str, roll);
+
+        __m256i merged = _mm256_maddubs_epi16(str, _mm256_set1_epi32(0x01400140));
+        __m256i words = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+        words = _mm256_shuffle_epi8(words, pack);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permutevar8x32_epi32(words, lanes));
+
+        consumed += 32;
+        out += 24;
+    }
+    return consumed;
+}
+
+Isa detectIsa() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return Isa::AVX2;
+    if (__builtin_cpu_supports("ssse3")) return Isa::SSSE3;
+    return Isa::Scalar;
+}
+
+#else
+
+Isa detectIsa() {
+    return Isa::Scalar;
+}
+
+#endif // BASE64_X86
+
+Isa bestIsa() {
+    static const Isa best = detectIsa();
+    return best;
+}
+
+std::atomic<Isa>& currentIsa() {
+    static std::atomic<Isa> isa(bestIsa());
+    return isa;
+}
+
+} // namespace
+
+size_t Base64::encode(const void* data, size_t size, char* out, Variant variant) {
+    const auto* in = static_cast<const uint8_t*>(data);
+    size_t consumed = 0;
+    size_t written = 0;
+
+#ifdef BASE64_X86
+    switch (currentIsa().load(std::memory_order_relaxed)) {
+    case Isa::AVX2:
+        consumed = encodeAvx2(in, size, out, variant);
+        break;
+    case Isa::SSSE3:
+        consumed = encodeSsse3(in, size, out, variant);
+        break;
+    case Isa::Scalar:
+        break;
+    }
+    written = consumed / 3 * 4;
+#endif
+
+    return written + encodeScalar(in + consumed, size - consumed, out + written, variant);
+}
+
+size_t Base64::decode(const char* text, size_t length, void* out, Variant variant) {
+    auto* bytes = static_cast<uint8_t*>(out);
+
+    if (variant == Variant::Standard && length > 0 && length % 4 == 0 && text[length - 1] == '=') {
+        length -= text[length - 2] == '=' ? 2 : 1;
+    }
+
+    size_t consumed = 0;
+    size_t written = 0;
+
+#ifdef BASE64_X86
+    if (variant == Variant::Standard) {
+        switch (currentIsa().load(std::memory_order_relaxed)) {
+        case Isa::AVX2:
+            consumed = decodeAvx2(text, length, bytes);
+            break;
+        case Isa::SSSE3:
+            consumed = decodeSsse3(text, length, bytes);
+            break;
+        case Isa::Scalar:
+            break;
+        }
+        written = consumed / 4 * 3;
+    }
+#endif
+
+    const DecodeTable& table = variant == Variant::Standard ? kStandardDecode : kUrlDecode;
+    size_t rest = decodeScalar(text + consumed, length - consumed, bytes + written, table);
+    return rest == npos ? npos : written + rest;
+}
+
+std::string Base64::encode(std::string_view data, Variant variant) {
+    std::string out(encodedSize(data.size(), variant), '\0');
+    out.resize(encode(data.data(), data.size(), &out[0], variant));
+    return out;
+}
+
+bool Base64::decode(std::string_view text, std::string& out, Variant variant) {
+    out.resize(maxDecodedSize(text.size()));
+    size_t written = decode(text.data(), text.size(), &out[0], variant);
+    if (written == npos) {
+        out.clear();
+        return false;
+    }
+    out.resize(written);
+    return true;
+}
+
+Base64::Isa Base64::isa() {
+    return currentIsa().load(std::memory_order_relaxed);
+}
+
+Base64::Isa Base64::setIsa(Isa isa) {
+    while (!supported(isa)) {
+        isa = static_cast<Isa>(static_cast<int>(isa) - 1);
+    }
+    currentIsa().store(isa, std::memory_order_relaxed);
+    return isa;
+}
+
+bool Base64::supported(Isa isa) {
+    return static_cast<int>(isa) <= static_cast<int>(bestIsa());
+}
+
+const char* Base64::isaName(Isa isa) {
+    switch (isa) {
+    case Isa::AVX2: return "AVX2";
+    case Isa::SSSE3: return "SSSE3";
+    case Isa::Scalar: break;
+    }
+    return "scalar";
+}
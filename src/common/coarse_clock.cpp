@@ -0,0 +1,105 @@
+// src/common/coarse_clock.cpp
+#include "coarse_clock.h"
+#include "iso8601.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+// Refresh thread and the value it publishes; 0 while stopped
+class Refresher {
+public:
+    ~Refresher() { stop(); }
+
+    void start(std::chrono::microseconds interval) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (thread_.joinable()) return;
+
+        stopping_ = false;
+        nowMs.store(CoarseClock::systemNowMs(), std::memory_order_relaxed);
+        thread_ = std::thread([this, interval] { run(interval); });
+    }
+
+    void stop() {
+        std::thread thread;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            thread.swap(thread_);
+        }
+        wakeup_.notify_all();
+        if (thread.joinable()) thread.join();
+        nowMs.store(0, std::memory_order_relaxed);
+    }
+
+    bool running() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return thread_.joinable();
+    }
+
+    std::atomic<int64_t> nowMs{0};
+
+private:
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::thread thread_;
+    bool stopping_ = false;
+
+    void run(std::chrono::microseconds interval) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            wakeup_.wait_for(lock, interval);
+            nowMs.store(CoarseClock::systemNowMs(), std::memory_order_relaxed);
+        }
+    }
+};
+
+Refresher& refresher() {
+    static Refresher instance;
+    return instance;
+}
+
+} // namespace
+
+void CoarseClock::start(std::chrono::microseconds interval) {
+    refresher().start(interval);
+}
+
+void CoarseClock::stop() {
+    refresher().stop();
+}
+
+bool CoarseClock::running() {
+    return refresher().running();
+}
+
+int64_t CoarseClock::nowMs() {
+    int64_t cached = refresher().nowMs.load(std::memory_order_relaxed);
+    return cached != 0 ? cached : systemNowMs();
+}
+
+int64_t CoarseClock::systemNowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void CoarseClock::formatNow(char* out) {
+    thread_local int64_t cachedSecond = std::numeric_limits<int64_t>::min();
+    thread_local char cachedText[Iso8601::kLength];
+
+    int64_t second = now();
+    if (second != cachedSecond) {
+        Iso8601::format(second, cachedText);
+        cachedSecond = second;
+    }
+    std::memcpy(out, cachedText, Iso8601::kLength);
+}
+
+std::string CoarseClock::formatNow() {
+    std::string text(Iso8601::kLength, '\0');
+    formatNow(text.data());
+    return text;
+}
@@ -0,0 +1,109 @@
+// src/common/iso8601.cpp
+#include "iso8601.h"
+
+namespace {
+
+constexpr int64_t kSecondsPerDay = 86400;
+
+static_assert(Iso8601::daysFromCivil(1970, 1, 1) == 0, "Unix epoch");
+static_assert(Iso8601::daysFromCivil(2000, 3, 1) == 11017, "leap century");
+
+// Reads exactly width digits
+bool readDigits(const char* p, int width, unsigned& value) {
+    value = 0;
+    for (int i = 0; i < width; i++) {
+        unsigned digit = static_cast<unsigned>(p[i] - '0');
+        if (digit > 9) return false;
+        value = value * 10 + digit;
+    }
+    return true;
+}
+
+void writeDigits(char* p, int width, unsigned value) {
+    for (int i = width - 1; i >= 0; i--) {
+        p[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+bool isLeapYear(unsigned year) {
+    return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+unsigned daysInMonth(unsigned year, unsigned month) {
+    static const unsigned days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return month == 2 && isLeapYear(year) ? 29 : days[month - 1];
+}
+
+} // namespace
+
+bool Iso8601::parse(std::string_view text, int64_t& epochSeconds) {
+    if (text.size() == kLength + 1 && text.back() == 'Z') {
+        text.remove_suffix(1);
+    }
+    if (text.size() != kLength) return false;
+
+    const char* p = text.data();
+    if (p[4] != '-' || p[7] != '-' || p[10] != 'T' || p[13] != ':' || p[16] != ':') {
+        return false;
+    }
+
+    unsigned year, month, day, hour, minute, second;
+    if (!readDigits(p, 4, year) || !readDigits(p + 5, 2, month) || !readDigits(p + 8, 2, day) ||
+        !readDigits(p + 11, 2, hour) || !readDigits(p + 14, 2, minute) || !readDigits(p + 17, 2, second)) {
+        return false;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month) ||
+        hour > 23 || minute > 59 || second > 59) {
+        return false;
+    }
+
+    epochSeconds = daysFromCivil(year, month, day) * kSecondsPerDay +
+                   hour * 3600 + minute * 60 + second;
+    return true;
+}
+
+void Iso8601::format(int64_t epochSeconds, char* out) {
+    int64_t days = epochSeconds / kSecondsPerDay;
+    int64_t rest = epochSeconds % kSecondsPerDay;
+    if (rest < 0) {
+        rest += kSecondsPerDay;
+        days--;
+    }
+
+    int64_t year;
+    unsigned month, day;
+    civilFromDays(days, year, month, day);
+
+    // Years outside 0000-9999 cannot be represented; clamp the digits
+    writeDigits(out, 4, static_cast<unsigned>(year < 0 ? 0 : year > 9999 ? 9999 : year));
+    out[4] = '-';
+    writeDigits(out + 5, 2, month);
+    out[7] = '-';
+    writeDigits(out + 8, 2, day);
+    out[10] = 'T';
+    writeDigits(out + 11, 2, static_cast<unsigned>(rest / 3600));
+    out[13] = ':';
+    writeDigits(out + 14, 2, static_cast<unsigned>(rest / 60 % 60));
+    out[16] = ':';
+    writeDigits(out + 17, 2, static_cast<unsigned>(rest % 60));
+}
+
+std::string Iso8601::format(int64_t epochSeconds) {
+    std::string text(kLength, '\0');
+    format(epochSeconds, &text[0]);
+    return text;
+}
+
+void Iso8601::civilFromDays(int64_t days, int64_t& year, unsigned& month, unsigned& day) {
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(days - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+
+    day = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = static_cast<int64_t>(yoe) + era * 400 + (month <= 2);
+}
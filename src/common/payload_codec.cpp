@@ -0,0 +1,236 @@
+// src/common/payload_codec.cpp
+#include "payload_codec.h"
+#include <stdexcept>
+#include <cstdlib>
+#include <cctype>
+
+namespace {
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) text.remove_suffix(1);
+    return text;
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Split off the next comma-separated entry
+std::string_view nextEntry(std::string_view& list) {
+    size_t comma = list.find(',');
+    std::string_view entry = trim(list.substr(0, comma));
+    list.remove_prefix(comma == std::string_view::npos ? list.size() : comma + 1);
+    return entry;
+}
+
+// q-value of one Accept entry in thousandths ("q=0.5" -> 500); 1000 when
+// absent, 0 when malformed
+int qValue(std::string_view params) {
+    while (!params.empty()) {
+        size_t semicolon = params.find(';');
+        std::string_view param = trim(params.substr(0, semicolon));
+        params.remove_prefix(semicolon == std::string_view::npos ? params.size() : semicolon + 1);
+
+        if (param.size() < 2 || (param[0] != 'q' && param[0] != 'Q') || param[1] != '=') continue;
+        std::string_view value = param.substr(2);
+        if (value.empty() || (value[0] != '0' && value[0] != '1')) return 0;
+
+        int q = (value[0] - '0') * 1000;
+        if (value.size() > 1) {
+            if (value[1] != '.' || value.size() > 5) return 0;
+            int scale = 100;
+            for (size_t i = 2; i < value.size(); i++, scale /= 10) {
+                if (!std::isdigit(static_cast<unsigned char>(value[i]))) return 0;
+                q += (value[i] - '0') * scale;
+            }
+        }
+        return q > 1000 ? 0 : q;
+    }
+    return 1000;
+}
+
+bool matchesFilter(std::string_view filter, std::string_view topic) {
+    if (filter == "#") return true;
+    if (filter.size() >= 2 && filter.substr(filter.size() - 2) == "/#") {
+        std::string_view prefix = filter.substr(0, filter.size() - 2);
+        return topic.substr(0, prefix.size()) == prefix &&
+               (topic.size() == prefix.size() || topic[prefix.size()] == '/');
+    }
+    return filter == topic;
+}
+
+} // namespace
+
+PayloadCodec::json PayloadCodec::parse(std::string_view payload, PayloadFormat format) {
+    switch (format) {
+    case PayloadFormat::Cbor: return json::from_cbor(payload.begin(), payload.end());
+    case PayloadFormat::MessagePack: return json::from_msgpack(payload.begin(), payload.end());
+    case PayloadFormat::Json: break;
+    }
+    return json::parse(payload.begin(), payload.end());
+}
+
+std::string PayloadCodec::dump(const json& value, PayloadFormat format) {
+    std::string out;
+    switch (format) {
+    case PayloadFormat::Cbor: json::to_cbor(value, out); break;
+    case PayloadFormat::MessagePack: json::to_msgpack(value, out); break;
+    case PayloadFormat::Json: out = value.dump(); break;
+    }
+    return out;
+}
+
+const char* PayloadCodec::contentType(PayloadFormat format) {
+    switch (format) {
+    case PayloadFormat::Json: return "application/json";
+    case PayloadFormat::Cbor: return "application/cbor";
+    case PayloadFormat::MessagePack: return "application/msgpack";
+    }
+    return "application/octet-stream";
+}
+
+bool PayloadCodec::fromContentType(std::string_view contentType, PayloadFormat& format) {
+    std::string_view type = trim(contentType.substr(0, contentType.find(';')));
+
+    if (equalsIgnoreCase(type, "application/json")) {
+        format = PayloadFormat::Json;
+    } else if (equalsIgnoreCase(type, "application/cbor")) {
+        format = PayloadFormat::Cbor;
+    } else if (equalsIgnoreCase(type, "application/msgpack") ||
+               equalsIgnoreCase(type, "application/x-msgpack") ||
+               equalsIgnoreCase(type, "application/vnd.msgpack")) {
+        format = PayloadFormat::MessagePack;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+PayloadFormat PayloadCodec::negotiate(std::string_view accept, PayloadFormat fallback) {
+    PayloadFormat best = fallback;
+    int bestQ = 0;
+
+    while (!accept.empty()) {
+        std::string_view entry = nextEntry(accept);
+        size_t semicolon = entry.find(';');
+        std::string_view type = trim(entry.substr(0, semicolon));
+        int q = semicolon == std::string_view::npos ? 1000 : qValue(entry.substr(semicolon + 1));
+
+        PayloadFormat format = fallback;
+        if (type != "*/*" && type != "application/*" && !fromContentType(type, format)) continue;
+        if (q > bestQ) {
+            best = format;
+            bestQ = q;
+        }
+    }
+    return best;
+}
+
+const char* PayloadCodec::name(PayloadFormat format) {
+    switch (format) {
+    case PayloadFormat::Json: return "json";
+    case PayloadFormat::Cbor: return "cbor";
+    case PayloadFormat::MessagePack: return "msgpack";
+    }
+    return "unknown";
+}
+
+bool PayloadCodec::fromName(std::string_view name, PayloadFormat& format) {
+    if (equalsIgnoreCase(name, "json")) {
+        format = PayloadFormat::Json;
+    } else if (equalsIgnoreCase(name, "cbor")) {
+        format = PayloadFormat::Cbor;
+    } else if (equalsIgnoreCase(name, "msgpack") || equalsIgnoreCase(name, "messagepack")) {
+        format = PayloadFormat::MessagePack;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+PayloadFormat PayloadCodec::fromEnvironment(const char* variable) {
+    const char* value = std::getenv(variable);
+    PayloadFormat format = PayloadFormat::Json;
+    if (value && *value && !fromName(trim(value), format)) {
+        throw std::invalid_argument(std::string("Unknown payload format in ") + variable + ": " + value);
+    }
+    return format;
+}
+
+void TopicFormats::set(std::string filter, PayloadFormat format) {
+    for (auto& entry : filters_) {
+        if (entry.first == filter) {
+            entry.second = format;
+            return;
+        }
+    }
+    filters_.emplace_back(std::move(filter), format);
+}
+
+PayloadFormat TopicFormats::forTopic(std::string_view topic) const {
+    PayloadFormat format = PayloadFormat::Json;
+    size_t bestLength = 0;
+    bool found = false;
+
+    // An exact topic outranks any wildcard; longer prefixes outrank shorter ones
+    for (const auto& [filter, entryFormat] : filters_) {
+        if (!matchesFilter(filter, topic)) continue;
+        size_t length = filter.back() == '#' ? filter.size() - 1 : topic.size() + 1;
+        if (!found || length > bestLength) {
+            format = entryFormat;
+            bestLength = length;
+            found = true;
+        }
+    }
+    return format;
+}
+
+std::string TopicFormats::describe() const {
+    std::string text;
+    for (const auto& [filter, format] : filters_) {
+        if (!text.empty()) text += ", ";
+        text += filter + "=" + PayloadCodec::name(format);
+    }
+    return text.empty() ? "json" : text;
+}
+
+TopicFormats TopicFormats::parse(std::string_view spec) {
+    TopicFormats formats;
+
+    while (!spec.empty()) {
+        std::string_view entry = nextEntry(spec);
+        if (entry.empty()) continue;
+
+        size_t equals = entry.rfind('=');
+        if (equals == std::string_view::npos) {
+            throw std::invalid_argument("Expected <topic>=<format>: " + std::string(entry));
+        }
+        std::string_view filter = trim(entry.substr(0, equals));
+        std::string_view name = trim(entry.substr(equals + 1));
+
+        size_t wildcard = filter.find_first_of("#+");
+        if (filter.empty() || (wildcard != std::string_view::npos &&
+                               !(wildcard == filter.size() - 1 && filter[wildcard] == '#' &&
+                                 (wildcard == 0 || filter[wildcard - 1] == '/')))) {
+            throw std::invalid_argument("Invalid topic filter: " + std::string(filter));
+        }
+        PayloadFormat format;
+        if (!PayloadCodec::fromName(name, format)) {
+            throw std::invalid_argument("Unknown payload format: " + std::string(name));
+        }
+        formats.set(std::string(filter), format);
+    }
+    return formats;
+}
+
+TopicFormats TopicFormats::fromEnvironment() {
+    const char* spec = std::getenv("MQTT_PAYLOAD_FORMATS");
+    return spec ? parse(spec) : TopicFormats();
+}
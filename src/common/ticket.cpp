@@ -1,21 +1,17 @@
 // src/common/ticket.cpp
 #include "ticket.h"
-#include <sstream>
-#include <iomanip>
-#include <ctime>
+#include "ticket_id.h"
+#include "base64.h"
+#include "iso8601.h"
 #include <stdexcept>
-#include <vector>
-
-// Base64 encoding table
-static const char base64_chars[] = 
-    "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-    "abcdefghijklmnopqrstuvwxyz"
-    "0123456789+/";
+#include <limits>
+#include <type_traits>
+#include <charconv>
 
 // Default constructor
 Ticket::Ticket() 
     : ticketId_(""), 
-      creationDate_(getCurrentDateISO()), 
+      creationTime_(currentTime()), 
       validityDays_(0), 
       lineNumber_(0) {
 }
@@ -23,26 +19,70 @@ Ticket::Ticket()
 // Parameterized constructor
 Ticket::Ticket(const std::string& id, int validityDays, int lineNumber)
     : ticketId_(id), 
-      creationDate_(getCurrentDateISO()),
+      creationTime_(currentTime()),
       validityDays_(validityDays), 
       lineNumber_(lineNumber) {
 }
 
+// Constructor for stored tickets (creation date already known)
+Ticket::Ticket(const std::string& id, const std::string& creationDate, int validityDays, int lineNumber)
+    : ticketId_(id),
+      creationTime_(parseCreationDate(creationDate)),
+      validityDays_(validityDays),
+      lineNumber_(lineNumber) {
+}
+
+Ticket::Ticket(const std::string& id, int64_t creationTime, int validityDays, int lineNumber)
+    : ticketId_(id),
+      creationTime_(creationTime),
+      validityDays_(validityDays),
+      lineNumber_(lineNumber) {
+}
+
+std::string Ticket::getCreationDate() const {
+    return Iso8601::format(creationTime_);
+}
+
+void Ticket::setCreationDate(const std::string& date) {
+    creationTime_ = parseCreationDate(date);
+}
+
 // Check if ticket is valid (has ID, validity days > 0, and not expired)
 bool Ticket::isValid() const {
-    return !ticketId_.empty() && validityDays_ > 0 && !isExpired();
+    return isValid(CoarseClock());
 }
 
 // Check if ticket has expired based on creation date and validity period
 bool Ticket::isExpired() const {
-    try {
-        auto creationTime = getCreationTimePoint();
-        auto now = std::chrono::system_clock::now();
-        auto validUntil = creationTime + std::chrono::hours(24 * validityDays_);
-        return now > validUntil;
-    } catch (const std::exception&) {
-        return true; // If date parsing fails, consider expired for safety
+    return isExpired(CoarseClock());
+}
+
+TicketRecord Ticket::toRecord() const {
+    TicketRecord record;
+    record.id = TicketRecord::packId(ticketId_);
+    record.creationTime = creationTime_;
+    record.validityDays = validityDays_;
+    record.lineNumber = lineNumber_;
+    return record;
+}
+
+Ticket Ticket::fromRecord(const TicketRecord& record, std::string_view legacyId) {
+    Ticket ticket(std::string(), record.creationTime, record.validityDays, record.lineNumber);
+    ticket.assign(record, legacyId);
+    return ticket;
+}
+
+void Ticket::assign(const TicketRecord& record, std::string_view legacyId) {
+    if (record.hasLegacyId()) {
+        ticketId_.assign(legacyId.data(), legacyId.size());
+    } else {
+        char id[TicketIdAllocator::kEncodedLength];
+        TicketIdAllocator::encode(record.id, id);
+        ticketId_.assign(id, sizeof(id));
     }
+    creationTime_ = record.creationTime;
+    validityDays_ = record.validityDays;
+    lineNumber_ = record.lineNumber;
 }
 
 // Serialize ticket to JSON string
@@ -59,97 +99,398 @@ Ticket Ticket::fromJson(const std::string& jsonStr) {
 
 // Serialize ticket to Base64 string (as required by task)
 std::string Ticket::toBase64() const {
-    std::string jsonStr = toJson();
-    return base64Encode(jsonStr);
+    std::string out;
+    std::string scratch;
+    appendBase64(out, scratch);
+    return out;
+}
+
+void Ticket::appendBase64(std::string& out, std::string& scratch) const {
+    char binary[kWireSize];
+    const char* payload = binary;
+    size_t size = kWireSize;
+
+    if (!toBinary(binary)) {
+        scratch.clear();
+        appendJsonPayload(scratch);
+        payload = scratch.data();
+        size = scratch.size();
+    }
+
+    size_t offset = out.size();
+    out.resize(offset + Base64::encodedSize(size));
+    Base64::encode(payload, size, &out[offset]);
 }
 
 // Deserialize ticket from Base64 string (as required by task)
 Ticket Ticket::fromBase64(const std::string& base64Str) {
-    std::string jsonStr = base64Decode(base64Str);
-    return fromJson(jsonStr);
-}
-
-// Parse creation date string to time_point
-std::chrono::system_clock::time_point Ticket::getCreationTimePoint() const {
-    std::tm tm = {};
-    std::istringstream ss(creationDate_);
-    ss >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%S");
-    
-    if (ss.fail()) {
-        throw std::runtime_error("Failed to parse creation date: " + creationDate_);
-    }
-    
-    return std::chrono::system_clock::from_time_t(std::mktime(&tm));
-}
-
-// Get current date/time in ISO 8601 format
-std::string Ticket::getCurrentDateISO() {
-    auto now = std::chrono::system_clock::now();
-    auto time = std::chrono::system_clock::to_time_t(now);
-    
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time), "%Y-%m-%dT%H:%M:%S");
-    return ss.str();
-}
-
-// Base64 encode implementation
-std::string Ticket::base64Encode(const std::string& input) {
-    std::string output;
-    int val = 0;
-    int valb = -6;
-    
-    for (unsigned char c : input) {
-        val = (val << 8) + c;
-        valb += 8;
-        while (valb >= 0) {
-            output.push_back(base64_chars[(val >> valb) & 0x3F]);
-            valb -= 6;
+    Ticket ticket;
+    if (!tryFromBase64(base64Str, ticket)) {
+        throw std::runtime_error("Invalid ticket data");
+    }
+    return ticket;
+}
+
+namespace {
+
+template <typename T>
+void putLE(char* out, size_t offset, T value) {
+    auto bits = static_cast<std::make_unsigned_t<T>>(value);
+    for (size_t i = 0; i < sizeof(T); i++) {
+        out[offset + i] = static_cast<char>((bits >> (8 * i)) & 0xFF);
+    }
+}
+
+template <typename T>
+T getLE(const char* in, size_t offset) {
+    std::make_unsigned_t<T> bits = 0;
+    for (size_t i = 0; i < sizeof(T); i++) {
+        bits |= static_cast<std::make_unsigned_t<T>>(static_cast<unsigned char>(in[offset + i])) << (8 * i);
+    }
+    return static_cast<T>(bits);
+}
+
+constexpr size_t kMaxTicketPayload = Ticket::kMaxPayloadSize;
+
+/**
+ * Minimal JSON object scanner for the ticket payload. Reads one flat
+ * object, hands each key with its raw value to the caller and skips
+ * nested values. Strings are unescaped into a caller-provided buffer.
+ */
+class JsonScanner {
+public:
+    explicit JsonScanner(std::string_view text) : p_(text.data()), end_(text.data() + text.size()) {}
+
+    bool consume(char c) {
+        skipSpace();
+        if (p_ < end_ && *p_ == c) {
+            p_++;
+            return true;
+        }
+        return false;
+    }
+
+    bool atEnd() {
+        skipSpace();
+        return p_ == end_;
+    }
+
+    // Key or string value, unescaped into buffer (capacity bytes)
+    bool readString(char* buffer, size_t capacity, size_t& length) {
+        if (!consume('"')) return false;
+        length = 0;
+
+        while (p_ < end_ && *p_ != '"') {
+            char c = *p_++;
+            if (static_cast<unsigned char>(c) < 0x20) return false;
+            if (c == '\\') {
+                if (p_ == end_) return false;
+                switch (*p_++) {
+                case '"': c = '"'; break;
+                case '\\': c = '\\'; break;
+                case '/': c = '/'; break;
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case 'n': c = '\n'; break;
+                case 'r': c = '\r'; break;
+                case 't': c = '\t'; break;
+                case 'u':
+                    if (!readUnicodeEscape(buffer, capacity, length)) return false;
+                    continue;
+                default: return false;
+                }
+            }
+            if (length == capacity) return false;
+            buffer[length++] = c;
+        }
+        return consume('"');
+    }
+
+    bool readInt(int& value) {
+        skipSpace();
+        const char* start = p_;
+        if (p_ < end_ && *p_ == '-') p_++;
+        while (p_ < end_ && *p_ >= '0' && *p_ <= '9') p_++;
+
+        auto result = std::from_chars(start, p_, value);
+        return result.ec == std::errc() && result.ptr == p_ && p_ != start;
+    }
+
+    // Skip any JSON value (used for unknown keys)
+    bool skipValue() {
+        skipSpace();
+        if (p_ == end_) return false;
+
+        if (*p_ == '"') {
+            char scratch[kMaxTicketPayload];
+            size_t length = 0;
+            return readString(scratch, sizeof(scratch), length);
+        }
+        if (*p_ == '{' || *p_ == '[') {
+            int depth = 0;
+            bool inString = false;
+            for (; p_ < end_; p_++) {
+                if (inString) {
+                    if (*p_ == '\\') p_++;
+                    else if (*p_ == '"') inString = false;
+                } else if (*p_ == '"') {
+                    inString = true;
+                } else if (*p_ == '{' || *p_ == '[') {
+                    depth++;
+                } else if ((*p_ == '}' || *p_ == ']') && --depth == 0) {
+                    p_++;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Number, true, false or null
+        const char* start = p_;
+        while (p_ < end_ && *p_ != ',' && *p_ != '}' && *p_ != ']' &&
+               *p_ != ' ' && *p_ != '\t' && *p_ != '\n' && *p_ != '\r') {
+            p_++;
+        }
+        return p_ != start;
+    }
+
+private:
+    const char* p_;
+    const char* end_;
+
+    void skipSpace() {
+        while (p_ < end_ && (*p_ == ' ' || *p_ == '\t' || *p_ == '\n' || *p_ == '\r')) p_++;
+    }
+
+    bool readHex4(uint32_t& value) {
+        if (end_ - p_ < 4) return false;
+        value = 0;
+        for (int i = 0; i < 4; i++) {
+            char c = *p_++;
+            uint32_t digit;
+            if (c >= '0' && c <= '9') digit = static_cast<uint32_t>(c - '0');
+            else if (c >= 'a' && c <= 'f') digit = static_cast<uint32_t>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') digit = static_cast<uint32_t>(c - 'A' + 10);
+            else return false;
+            value = (value << 4) | digit;
+        }
+        return true;
+    }
+
+    // \uXXXX (with surrogate pairs), written as UTF-8
+    bool readUnicodeEscape(char* buffer, size_t capacity, size_t& length) {
+        uint32_t code;
+        if (!readHex4(code)) return false;
+        if (code >= 0xD800 && code <= 0xDBFF) {
+            uint32_t low;
+            if (end_ - p_ < 6 || p_[0] != '\\' || p_[1] != 'u') return false;
+            p_ += 2;
+            if (!readHex4(low) || low < 0xDC00 || low > 0xDFFF) return false;
+            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
         }
+
+        char utf8[4];
+        size_t n;
+        if (code < 0x80) {
+            utf8[0] = static_cast<char>(code);
+            n = 1;
+        } else if (code < 0x800) {
+            utf8[0] = static_cast<char>(0xC0 | (code >> 6));
+            utf8[1] = static_cast<char>(0x80 | (code & 0x3F));
+            n = 2;
+        } else if (code < 0x10000) {
+            utf8[0] = static_cast<char>(0xE0 | (code >> 12));
+            utf8[1] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            utf8[2] = static_cast<char>(0x80 | (code & 0x3F));
+            n = 3;
+        } else {
+            utf8[0] = static_cast<char>(0xF0 | (code >> 18));
+            utf8[1] = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            utf8[2] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            utf8[3] = static_cast<char>(0x80 | (code & 0x3F));
+            n = 4;
+        }
+
+        if (capacity - length < n) return false;
+        for (size_t i = 0; i < n; i++) buffer[length++] = utf8[i];
+        return true;
+    }
+};
+
+} // namespace
+
+bool Ticket::tryFromBase64(std::string_view base64Str, Ticket& ticket) {
+    if (Base64::maxDecodedSize(base64Str.size()) > kMaxTicketPayload) {
+        return false;
+    }
+
+    char payload[kMaxTicketPayload];
+    size_t size = Base64::decode(base64Str.data(), base64Str.size(), payload);
+    if (size == Base64::npos || size == 0) {
+        return false;
+    }
+
+    return tryFromPayload(payload, size, ticket);
+}
+
+bool Ticket::tryFromPayload(const char* data, size_t size, Ticket& ticket) {
+    // Legacy tickets carry JSON, which always starts with '{'
+    if (size > 0 && data[0] == '{') {
+        return scanJson(std::string_view(data, size), ticket);
+    }
+    return tryFromBinary(data, size, ticket);
+}
+
+bool Ticket::tryFromBinary(const char* data, size_t size, Ticket& ticket) {
+    if (size < kWireSize || static_cast<uint8_t>(data[0]) != kWireVersion) {
+        return false;
+    }
+    bool isSigned = (static_cast<uint8_t>(data[1]) & kWireFlagSigned) != 0;
+    if (size != (isSigned ? kWireSize + kWireSignatureSize : kWireSize)) {
+        return false;
+    }
+
+    char id[TicketIdAllocator::kEncodedLength];
+    TicketIdAllocator::encode(getLE<uint64_t>(data, 8), id);
+    ticket.ticketId_.assign(id, sizeof(id));
+    ticket.creationTime_ = getLE<int64_t>(data, 16);
+    ticket.validityDays_ = getLE<uint16_t>(data, 2);
+    ticket.lineNumber_ = static_cast<int>(getLE<uint32_t>(data, 4));
+    return true;
+}
+
+bool Ticket::scanJson(std::string_view text, Ticket& ticket) {
+    JsonScanner scanner(text);
+    if (!scanner.consume('{')) return false;
+
+    enum : unsigned { kId = 1, kDate = 2, kValidity = 4, kLine = 8, kAll = 15 };
+    unsigned seen = 0;
+    char key[kMaxTicketPayload];
+    char value[kMaxTicketPayload];
+    size_t keyLength = 0;
+    size_t valueLength = 0;
+
+    if (!scanner.consume('}')) {
+        do {
+            if (!scanner.readString(key, sizeof(key), keyLength) || !scanner.consume(':')) {
+                return false;
+            }
+            std::string_view name(key, keyLength);
+
+            if (name == "ticketId") {
+                if (!scanner.readString(value, sizeof(value), valueLength)) return false;
+                ticket.ticketId_.assign(value, valueLength);
+                seen |= kId;
+            } else if (name == "creationDate") {
+                if (!scanner.readString(value, sizeof(value), valueLength) ||
+                    !Iso8601::parse(std::string_view(value, valueLength), ticket.creationTime_)) {
+                    return false;
+                }
+                seen |= kDate;
+            } else if (name == "validityDays") {
+                if (!scanner.readInt(ticket.validityDays_)) return false;
+                seen |= kValidity;
+            } else if (name == "lineNumber") {
+                if (!scanner.readInt(ticket.lineNumber_)) return false;
+                seen |= kLine;
+            } else if (!scanner.skipValue()) {
+                return false;
+            }
+        } while (scanner.consume(','));
+
+        if (!scanner.consume('}')) return false;
+    }
+
+    return seen == kAll && scanner.atEnd();
+}
+
+bool Ticket::toBinary(std::string& out) const {
+    char binary[kWireSize];
+    if (!toBinary(binary)) {
+        return false;
+    }
+    out.assign(binary, kWireSize);
+    return true;
+}
+
+bool Ticket::toBinary(char* out) const {
+    uint64_t id = 0;
+    if (!TicketIdAllocator::decodeCanonical(ticketId_, id)) {
+        return false;
+    }
+    if (validityDays_ < 0 || validityDays_ > std::numeric_limits<uint16_t>::max() || lineNumber_ < 0) {
+        return false;
     }
-    
-    if (valb > -6) {
-        output.push_back(base64_chars[((val << 8) >> (valb + 8)) & 0x3F]);
-    }
-    
-    // Add padding
-    while (output.size() % 4) {
-        output.push_back('=');
-    }
-    
-    return output;
-}
-
-// Base64 decode implementation
-std::string Ticket::base64Decode(const std::string& input) {
-    std::string output;
-    std::vector<int> T(256, -1);
-    
-    // Build decoding table
-    for (int i = 0; i < 64; i++) {
-        T[base64_chars[i]] = i;
-    }
-    
-    int val = 0;
-    int valb = -8;
-    
-    for (unsigned char c : input) {
-        if (T[c] == -1) break;
-        val = (val << 6) + T[c];
-        valb += 6;
-        if (valb >= 0) {
-            output.push_back(char((val >> valb) & 0xFF));
-            valb -= 8;
+
+    putLE<uint8_t>(out, 0, kWireVersion);
+    putLE<uint8_t>(out, 1, 0);
+    putLE<uint16_t>(out, 2, static_cast<uint16_t>(validityDays_));
+    putLE<uint32_t>(out, 4, static_cast<uint32_t>(lineNumber_));
+    putLE<uint64_t>(out, 8, id);
+    putLE<int64_t>(out, 16, creationTime_);
+    return true;
+}
+
+Ticket Ticket::fromBinary(const std::string& data) {
+    Ticket ticket;
+    if (!tryFromBinary(data.data(), data.size(), ticket)) {
+        throw std::runtime_error("Unsupported ticket encoding");
+    }
+    return ticket;
+}
+
+int64_t Ticket::parseCreationDate(const std::string& date) {
+    int64_t epochSeconds = 0;
+    if (!Iso8601::parse(date, epochSeconds)) {
+        throw std::invalid_argument("Invalid creation date: " + date);
+    }
+    return epochSeconds;
+}
+
+// Same document as toJson(), written without building a DOM
+void Ticket::appendJsonPayload(std::string& out) const {
+    static const char kHex[] = "0123456789abcdef";
+    char number[16];
+
+    out += "{\"creationDate\":\"";
+    char date[Iso8601::kLength];
+    Iso8601::format(creationTime_, date);
+    out.append(date, sizeof(date));
+
+    out += "\",\"lineNumber\":";
+    out.append(number, std::to_chars(number, number + sizeof(number), lineNumber_).ptr);
+
+    out += ",\"ticketId\":\"";
+    for (char c : ticketId_) {
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\b': out += "\\b"; break;
+        case '\f': out += "\\f"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                out += "\\u00";
+                out += kHex[c >> 4];
+                out += kHex[c & 0xF];
+            } else {
+                out += c;
+            }
         }
     }
-    
-    return output;
+
+    out += "\",\"validityDays\":";
+    out.append(number, std::to_chars(number, number + sizeof(number), validityDays_).ptr);
+    out += '}';
 }
 
 // JSON serialization (for nlohmann::json)
 void to_json(json& j, const Ticket& t) {
     j = json{
         {"ticketId", t.ticketId_},
-        {"creationDate", t.creationDate_},
+        {"creationDate", t.getCreationDate()},
         {"validityDays", t.validityDays_},
         {"lineNumber", t.lineNumber_}
     };
@@ -158,7 +499,7 @@ void to_json(json& j, const Ticket& t) {
 // JSON deserialization (for nlohmann::json)
 void from_json(const json& j, Ticket& t) {
     j.at("ticketId").get_to(t.ticketId_);
-    j.at("creationDate").get_to(t.creationDate_);
+    t.creationTime_ = Ticket::parseCreationDate(j.at("creationDate").get<std::string>());
     j.at("validityDays").get_to(t.validityDays_);
     j.at("lineNumber").get_to(t.lineNumber_);
 }
@@ -0,0 +1,66 @@
+// src/common/ticket_codec.cpp
+#include "ticket_codec.h"
+#include "ticket_signer.h"
+#include "base64.h"
+
+namespace {
+
+// Binary tickets encode to 32 characters, signed ones to 48
+constexpr size_t kTypicalEncodedSize = 48;
+
+template <typename Text>
+size_t decodeAll(const Text* texts, size_t count, Ticket* tickets, TicketCodec::Status* statuses) {
+    size_t decoded = 0;
+    for (size_t i = 0; i < count; i++) {
+        statuses[i] = TicketCodec::decode(texts[i], tickets[i]);
+        if (statuses[i] == TicketCodec::Status::Ok) decoded++;
+    }
+    return decoded;
+}
+
+} // namespace
+
+void TicketCodec::encodeMany(const Ticket* tickets, size_t count, std::string& out, size_t* ends,
+                             const TicketSigner* signer) {
+    out.reserve(out.size() + count * kTypicalEncodedSize);
+    bool sign = signer && signer->canSign();
+    std::string scratch;
+
+    for (size_t i = 0; i < count; i++) {
+        if (!sign || !signer->appendSigned(tickets[i], out)) {
+            tickets[i].appendBase64(out, scratch);
+        }
+        ends[i] = out.size();
+    }
+}
+
+size_t TicketCodec::decodeMany(const std::string_view* texts, size_t count, Ticket* tickets, Status* statuses) {
+    return decodeAll(texts, count, tickets, statuses);
+}
+
+size_t TicketCodec::decodeMany(const std::string* texts, size_t count, Ticket* tickets, Status* statuses) {
+    return decodeAll(texts, count, tickets, statuses);
+}
+
+TicketCodec::Status TicketCodec::decode(std::string_view text, Ticket& ticket) {
+    if (Base64::maxDecodedSize(text.size()) > Ticket::kMaxPayloadSize) {
+        return Status::TooLong;
+    }
+
+    char payload[Ticket::kMaxPayloadSize];
+    size_t size = Base64::decode(text.data(), text.size(), payload);
+    if (size == Base64::npos) {
+        return Status::InvalidBase64;
+    }
+    return Ticket::tryFromPayload(payload, size, ticket) ? Status::Ok : Status::InvalidPayload;
+}
+
+const char* TicketCodec::statusName(Status status) {
+    switch (status) {
+    case Status::Ok: return "ok";
+    case Status::TooLong: return "ticket too long";
+    case Status::InvalidBase64: return "invalid Base64";
+    case Status::InvalidPayload: return "invalid ticket data";
+    }
+    return "unknown";
+}
@@ -0,0 +1,128 @@
+// src/common/ticket_id.cpp
+#include "ticket_id.h"
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace {
+
+const char kAlphabet[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+
+int decodeDigit(char c) {
+    if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+    if (c == 'O') return 0;
+    if (c == 'I' || c == 'L') return 1;
+
+    for (int i = 0; i < 32; i++) {
+        if (kAlphabet[i] == c) return i;
+    }
+    return -1;
+}
+
+} // namespace
+
+TicketIdAllocator::TicketIdAllocator(uint32_t nodeId, Clock clock)
+    : nodeId_(nodeId),
+      clock_(clock),
+      state_(0) {
+    if (nodeId > kMaxNodeId) {
+        throw std::invalid_argument("Ticket ID node must be between 0 and " + std::to_string(kMaxNodeId));
+    }
+}
+
+uint64_t TicketIdAllocator::next() {
+    return compose(reserve(1));
+}
+
+std::vector<uint64_t> TicketIdAllocator::allocateBlock(size_t count) {
+    std::vector<uint64_t> ids;
+    if (count == 0) return ids;
+
+    uint64_t first = reserve(count);
+    ids.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        ids.push_back(compose(first + i));
+    }
+    return ids;
+}
+
+// Returns the first of count consecutive states
+uint64_t TicketIdAllocator::reserve(uint64_t count) {
+    int64_t elapsed = clock_() - kEpochMs;
+    uint64_t floor = static_cast<uint64_t>(elapsed > 0 ? elapsed : 0) << kSequenceBits;
+
+    uint64_t current = state_.load(std::memory_order_relaxed);
+    uint64_t first;
+    do {
+        first = current + 1 > floor ? current + 1 : floor;
+    } while (!state_.compare_exchange_weak(current, first + count - 1,
+                                           std::memory_order_relaxed, std::memory_order_relaxed));
+    return first;
+}
+
+uint64_t TicketIdAllocator::compose(uint64_t state) const {
+    uint64_t timestamp = state >> kSequenceBits;
+    uint64_t sequence = state & ((1u << kSequenceBits) - 1);
+
+    return (timestamp << (kNodeBits + kSequenceBits)) |
+           (static_cast<uint64_t>(nodeId_) << kSequenceBits) |
+           sequence;
+}
+
+uint32_t TicketIdAllocator::nodeIdFromEnvironment() {
+    const char* value = std::getenv("BACKOFFICE_NODE_ID");
+    if (!value || !*value) return 0;
+
+    char* end = nullptr;
+    unsigned long node = std::strtoul(value, &end, 10);
+    if (*end != '\0' || node > kMaxNodeId) {
+        throw std::invalid_argument(std::string("Invalid BACKOFFICE_NODE_ID: ") + value);
+    }
+    return static_cast<uint32_t>(node);
+}
+
+std::string TicketIdAllocator::encode(uint64_t id) {
+    std::string text(kEncodedLength, '0');
+    encode(id, text.data());
+    return text;
+}
+
+void TicketIdAllocator::encode(uint64_t id, char* out) {
+    for (size_t i = kEncodedLength; i-- > 0;) {
+        out[i] = kAlphabet[id & 31];
+        id >>= 5;
+    }
+}
+
+bool TicketIdAllocator::decode(std::string_view text, uint64_t& id) {
+    if (text.size() != kEncodedLength) return false;
+
+    uint64_t value = 0;
+    for (size_t i = 0; i < kEncodedLength; i++) {
+        int digit = decodeDigit(text[i]);
+        if (digit < 0) return false;
+        // 13 digits carry 65 bits: the leading digit only holds 4 of them
+        if (i == 0 && digit > 15) return false;
+        value = (value << 5) | static_cast<uint64_t>(digit);
+    }
+
+    id = value;
+    return true;
+}
+
+bool TicketIdAllocator::decodeCanonical(std::string_view text, uint64_t& id) {
+    uint64_t value = 0;
+    if (!decode(text, value)) return false;
+
+    char canonical[kEncodedLength];
+    encode(value, canonical);
+    if (text != std::string_view(canonical, kEncodedLength)) return false;
+
+    id = value;
+    return true;
+}
+
+int64_t TicketIdAllocator::systemClock() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,200 @@
+// src/common/ticket_signer.cpp
+#include "ticket_signer.h"
+#include "base64.h"
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <stdexcept>
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+
+namespace {
+
+constexpr size_t kSignedSize = Ticket::kWireSize + Ticket::kWireSignatureSize;
+
+int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+std::string decodeHex(std::string_view hex) {
+    if (hex.size() % 2 != 0) {
+        throw std::invalid_argument("Signing key must be an even number of hex digits");
+    }
+
+    std::string bytes(hex.size() / 2, '\0');
+    for (size_t i = 0; i < bytes.size(); i++) {
+        int high = hexDigit(hex[2 * i]);
+        int low = hexDigit(hex[2 * i + 1]);
+        if (high < 0 || low < 0) {
+            throw std::invalid_argument("Signing key is not hexadecimal");
+        }
+        bytes[i] = static_cast<char>(high << 4 | low);
+    }
+    return bytes;
+}
+
+uint8_t parseKeyId(std::string_view text) {
+    unsigned value = 0;
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (text.empty() || result.ec != std::errc() || result.ptr != text.data() + text.size() ||
+        value > TicketSigner::kMaxKeyId) {
+        throw std::invalid_argument("Invalid signing key ID: " + std::string(text));
+    }
+    return static_cast<uint8_t>(value);
+}
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) text.remove_suffix(1);
+    return text;
+}
+
+} // namespace
+
+void TicketSigner::addKey(uint8_t keyId, std::string secret) {
+    if (keyId > kMaxKeyId) {
+        throw std::invalid_argument("Signing key ID must be 0-" + std::to_string(kMaxKeyId));
+    }
+    if (secret.size() < kMinKeySize) {
+        throw std::invalid_argument("Signing key " + std::to_string(keyId) + " is shorter than " +
+                                    std::to_string(kMinKeySize) + " bytes");
+    }
+    keys_[keyId] = std::move(secret);
+}
+
+void TicketSigner::setActiveKey(uint8_t keyId) {
+    if (keyId > kMaxKeyId || keys_[keyId].empty()) {
+        throw std::invalid_argument("Unknown signing key ID: " + std::to_string(keyId));
+    }
+    activeKey_ = keyId;
+}
+
+bool TicketSigner::hasKeys() const {
+    for (const auto& key : keys_) {
+        if (!key.empty()) return true;
+    }
+    return false;
+}
+
+bool TicketSigner::sign(const Ticket& ticket, std::string& base64) const {
+    base64.clear();
+    return appendSigned(ticket, base64);
+}
+
+bool TicketSigner::appendSigned(const Ticket& ticket, std::string& out) const {
+    char payload[kSignedSize];
+    if (!canSign() || !ticket.toBinary(payload)) {
+        return false;
+    }
+
+    uint8_t keyId = static_cast<uint8_t>(activeKey_);
+    payload[1] = static_cast<char>(Ticket::kWireFlagSigned | keyId << Ticket::kWireKeyIdShift);
+    computeMac(keyId, payload, Ticket::kWireSize, reinterpret_cast<unsigned char*>(payload + Ticket::kWireSize));
+
+    size_t offset = out.size();
+    out.resize(offset + Base64::encodedSize(kSignedSize));
+    Base64::encode(payload, kSignedSize, &out[offset]);
+    return true;
+}
+
+TicketSigner::Status TicketSigner::verify(std::string_view base64, Ticket& ticket) const {
+    // Anything longer than a signed ticket is at best an unsigned JSON ticket
+    if (Base64::maxDecodedSize(base64.size()) > kSignedSize) {
+        return Ticket::tryFromBase64(base64, ticket) ? Status::Unsigned : Status::Malformed;
+    }
+
+    char payload[kSignedSize];
+    size_t size = Base64::decode(base64.data(), base64.size(), payload);
+    if (size == Base64::npos || size == 0) {
+        return Status::Malformed;
+    }
+    if (payload[0] == '{') {
+        return Ticket::tryFromBase64(base64, ticket) ? Status::Unsigned : Status::Malformed;
+    }
+    if (!Ticket::tryFromBinary(payload, size, ticket)) {
+        return Status::Malformed;
+    }
+
+    uint8_t flags = static_cast<uint8_t>(payload[1]);
+    if ((flags & Ticket::kWireFlagSigned) == 0) {
+        return Status::Unsigned;
+    }
+
+    uint8_t keyId = flags >> Ticket::kWireKeyIdShift;
+    if (keys_[keyId].empty()) {
+        return Status::UnknownKey;
+    }
+
+    unsigned char mac[kSignatureSize];
+    computeMac(keyId, payload, Ticket::kWireSize, mac);
+    if (CRYPTO_memcmp(mac, payload + Ticket::kWireSize, kSignatureSize) != 0) {
+        return Status::BadSignature;
+    }
+    return Status::Valid;
+}
+
+void TicketSigner::computeMac(uint8_t keyId, const char* data, size_t size, unsigned char* mac) const {
+    const std::string& key = keys_[keyId];
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int digestSize = 0;
+
+    if (!HMAC(EVP_sha256(), key.data(), static_cast<int>(key.size()),
+              reinterpret_cast<const unsigned char*>(data), size, digest, &digestSize) ||
+        digestSize < kSignatureSize) {
+        throw std::runtime_error("HMAC-SHA256 failed");
+    }
+    std::copy(digest, digest + kSignatureSize, mac);
+    OPENSSL_cleanse(digest, sizeof(digest));
+}
+
+TicketSigner TicketSigner::fromEnvironment() {
+    const char* keys = std::getenv("TICKET_SIGNING_KEYS");
+    const char* active = std::getenv("TICKET_SIGNING_KEY_ID");
+    if (!keys || !*keys) {
+        return TicketSigner();
+    }
+    return parse(keys, active ? active : "");
+}
+
+TicketSigner TicketSigner::parse(std::string_view keys, std::string_view activeKeyId) {
+    TicketSigner signer;
+    int lastKey = -1;
+
+    while (!keys.empty()) {
+        size_t comma = keys.find(',');
+        std::string_view entry = trim(keys.substr(0, comma));
+        keys.remove_prefix(comma == std::string_view::npos ? keys.size() : comma + 1);
+        if (entry.empty()) continue;
+
+        size_t colon = entry.find(':');
+        if (colon == std::string_view::npos) {
+            throw std::invalid_argument("Signing key must be <id>:<hex secret>");
+        }
+        uint8_t keyId = parseKeyId(trim(entry.substr(0, colon)));
+        signer.addKey(keyId, decodeHex(trim(entry.substr(colon + 1))));
+        lastKey = keyId;
+    }
+
+    activeKeyId = trim(activeKeyId);
+    if (!activeKeyId.empty()) {
+        signer.setActiveKey(parseKeyId(activeKeyId));
+    } else if (lastKey >= 0) {
+        signer.setActiveKey(static_cast<uint8_t>(lastKey));
+    }
+    return signer;
+}
+
+const char* TicketSigner::statusName(Status status) {
+    switch (status) {
+    case Status::Valid: return "valid";
+    case Status::Unsigned: return "unsigned";
+    case Status::UnknownKey: return "unknown key";
+    case Status::BadSignature: return "bad signature";
+    case Status::Malformed: return "malformed";
+    }
+    return "unknown";
+}
@@ -0,0 +1,52 @@
+// src/gate/backoffice_client.cpp
+#include "backoffice_client.h"
+
+BackOfficeClient::BackOfficeClient(const std::string& url)
+    : BackOfficeClient(url, Config()) {
+}
+
+BackOfficeClient::BackOfficeClient(const std::string& url, Config config)
+    : url_(url), config_(config),
+      pool_([this] { return connect(); }, config.pool) {
+}
+
+std::unique_ptr<httplib::Client> BackOfficeClient::connect() const {
+    auto client = std::make_unique<httplib::Client>(url_);
+    client->set_keep_alive(true);
+    client->set_connection_timeout(config_.connectTimeout.count(), 0);
+    client->set_read_timeout(config_.readTimeout.count(), 0);
+    return client;
+}
+
+httplib::Result BackOfficeClient::post(const std::string& path, const httplib::Headers& headers,
+                                       const std::string& body, const std::string& contentType) {
+    requests_.fetch_add(1, std::memory_order_relaxed);
+
+    Pool::Lease client = pool_.acquire();
+    httplib::Result res = client->Post(path, headers, body, contentType);
+    if (res) return res;
+
+    // Only this connection is suspect; a read timeout says nothing about the others
+    client.markBroken();
+    bool notSent = res.error() == httplib::Error::Connection || res.error() == httplib::Error::Write;
+    if (!client.reused() || !notSent) {
+        return res;
+    }
+
+    // A reused connection the server closed while idle: the request never
+    // reached it, so it is safe to send again on another connection
+    reconnects_.fetch_add(1, std::memory_order_relaxed);
+    client = Pool::Lease();
+    client = pool_.acquire();
+    res = client->Post(path, headers, body, contentType);
+    if (!res) client.markBroken();
+    return res;
+}
+
+BackOfficeClient::Stats BackOfficeClient::stats() const {
+    Stats stats;
+    stats.connections = pool_.stats();
+    stats.requests = requests_.load(std::memory_order_relaxed);
+    stats.reconnects = reconnects_.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -2,20 +2,25 @@
 #include <iostream>
 #include <vector>
 #include <sstream>
+#include <utility>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+#include <cstdlib>
 #include <httplib.h>
 #include <nlohmann/json.hpp>
 #include <mqtt/async_client.h>
 #include "ticket.h"
+#include "ticket_signer.h"
+#include "coarse_clock.h"
+#include "payload_codec.h"
+#include "backoffice_client.h"
+#include "validation_pipeline.h"
+#include "report_shipper.h"
+#include "verdict_cache.h"
 
 using json = nlohmann::json;
 
-struct ValidationRecord {
-    std::string ticketId;
-    std::string timestamp;
-    bool valid;
-    std::string validationMode; // "online" or "offline"
-};
-
 /**
  * @brief Gate Validator Service
  * 
@@ -23,23 +28,49 @@ struct ValidationRecord {
  * - Receive ticket Base64 via MQTT
  * - Validate online through Back-Office (REST API)
  * - If Back-Office unavailable: offline validation (expiry date only)
+ * - With a signing keyring (TICKET_SIGNING_KEYS, see TicketSigner): tickets
+ *   with a valid signature are decided locally without the round trip,
+ *   forged ones are refused, and offline validation only accepts signed
+ *   tickets
  * - Open/Close gate based on validation
  * - Maintain XML transactions and send to Back-Office
+ *
+ * MQTT payloads are JSON unless MQTT_PAYLOAD_FORMATS selects CBOR or
+ * MessagePack for a topic; BACKOFFICE_PAYLOAD_FORMAT does the same for
+ * online validation (see PayloadCodec). Reports stay XML.
+ *
+ * Calls to the Back-Office share a pool of keep-alive connections (see
+ * BackOfficeClient); reports include how often connections were reused.
+ *
+ * Requests are decoded on the MQTT consumer thread and validated on a
+ * ValidationPipeline: several tickets in flight at once, each ticket's
+ * responses in order, and the consumer held back when the queues are full.
+ * Reports are sent by a ReportShipper thread, never on the tap path.
  */
 class GateService {
 public:
     GateService(const std::string& gateId, const std::string& mqttBroker, 
-                const std::string& backOfficeUrl)
+                const std::string& backOfficeUrl, TicketSigner signer,
+                TopicFormats topicFormats = {}, PayloadFormat restFormat = PayloadFormat::Json,
+                ValidationPipeline::Config pipeline = {}, ReportShipper::Config reports = {},
+                VerdictCache::Config verdicts = {})
         : gateId_(gateId),
           mqttClient_(mqttBroker, "GATE-" + gateId),
-          backOfficeUrl_(backOfficeUrl),
-          totalProcessed_(0),
-          validCount_(0),
-          invalidCount_(0),
-          running_(true) {
+          backOffice_(backOfficeUrl),
+          signer_(std::move(signer)),
+          topicFormats_(std::move(topicFormats)),
+          restFormat_(restFormat),
+          pipeline_(pipeline),
+          verdicts_(verdicts),
+          running_(true),
+          reports_([this](const std::vector<ValidationRecord>& records) { return buildReport(records); },
+                   [this](const std::string& report) { return postReport(report); },
+                   reports) {
     }
 
     ~GateService() {
+        pipeline_.stop();
+        reports_.stop();
         disconnect();
     }
 
@@ -49,7 +80,12 @@ public:
         std::cout << "╚════════════════════════════════════════╝" << std::endl;
         std::cout << "Gate ID: " << gateId_ << std::endl;
         std::cout << "MQTT Broker: " << mqttClient_.get_server_uri() << std::endl;
-        std::cout << "Back-Office: " << backOfficeUrl_ << std::endl;
+        std::cout << "Back-Office: " << backOffice_.url() << " (keep-alive)" << std::endl;
+        std::cout << "Workers: " << pipeline_.workerCount() << " (queue " << pipeline_.queueCapacity()
+                  << " per worker)" << std::endl;
+        std::cout << "Payload Formats: MQTT " << topicFormats_.describe()
+                  << ", REST " << PayloadCodec::name(restFormat_) << std::endl;
+        std::cout << "Signature Check: " << (signer_.hasKeys() ? "enabled" : "disabled") << std::endl;
         std::cout << "----------------------------------------" << std::endl;
         
         // Connect and subscribe
@@ -62,19 +98,26 @@ public:
 
     void stop() {
         running_ = false;
+        pipeline_.stop();
+        reports_.stop();
         disconnect();
     }
 
 private:
     std::string gateId_;
     mqtt::async_client mqttClient_;
-    std::string backOfficeUrl_;
+    BackOfficeClient backOffice_;
+    TicketSigner signer_;
+    TopicFormats topicFormats_;
+    PayloadFormat restFormat_;
+    
+    ValidationPipeline pipeline_;
     
-    int totalProcessed_;
-    int validCount_;
-    int invalidCount_;
-    std::vector<ValidationRecord> validationHistory_;
+    VerdictCache verdicts_;      // Recent online verdicts, by ticket ID
+    std::atomic<uint64_t> validCount_{0};    // Shared by the workers
+    std::atomic<uint64_t> invalidCount_{0};
     bool running_;
+    ReportShipper reports_;  // Last: its thread calls back into the members above
 
     void connectMQTT() {
         try {
@@ -133,94 +176,133 @@ private:
                     break;
                 }
                 
-                handleValidationRequest(msg->to_string());
+                handleValidationRequest(msg->get_topic(), msg->to_string());
             }
         } catch (const mqtt::exception& exc) {
             std::cerr << "✗ Consume error: " << exc.what() << std::endl;
         }
     }
 
-    void handleValidationRequest(const std::string& payload) {
+    // Decode stage, on the MQTT consumer thread: parse and decode, then
+    // hand the ticket to the worker owning its ID (blocks while full)
+    void handleValidationRequest(const std::string& topic, const std::string& payload) {
         try {
-            std::cout << "\n=== Validation Request [Gate " << gateId_ << "] ===" << std::endl;
-            
-            // Parse MQTT message
-            json request = json::parse(payload);
-            std::string ticketBase64 = request["ticketBase64"];
-            
-            std::cout << "Ticket (Base64): " << ticketBase64.substr(0, 30) << "..." << std::endl;
-            
-            // Decode ticket
-            Ticket ticket = Ticket::fromBase64(ticketBase64);
-            std::cout << "Ticket ID: " << ticket.getId() << std::endl;
-            std::cout << "Line Number: " << ticket.getLineNumber() << std::endl;
-            std::cout << "Validity: " << ticket.getValidityDays() << " days" << std::endl;
-            
-            // Try online validation first
-            bool valid = false;
-            std::string validationMode = "online";
-            std::string message;
-            
-            if (validateOnline(ticketBase64, valid, message)) {
-                std::cout << "✓ Online validation successful" << std::endl;
-            } else {
-                std::cout << "⚠ Back-Office unavailable - Using offline validation" << std::endl;
-                valid = validateOffline(ticket);
-                validationMode = "offline";
-                message = valid ? "Valid (offline check - expiry only)" : "Expired (offline check)";
+            json request = PayloadCodec::parse(payload, topicFormats_.forTopic(topic));
+            std::string ticketBase64 = request.at("ticketBase64");
+            
+            // Decode ticket and check its signature
+            Ticket ticket;
+            TicketSigner::Status signature = signer_.verify(ticketBase64, ticket);
+            if (signature == TicketSigner::Status::Malformed) {
+                throw std::invalid_argument("Invalid ticket data");
             }
             
-            // Record validation
-            recordValidation(ticket.getId(), valid, validationMode);
-            
-            // Gate decision
-            std::string gateAction = valid ? "OPEN" : "CLOSED";
-            std::cout << "\n🚪 Gate Action: " << gateAction << std::endl;
-            std::cout << "Message: " << message << std::endl;
-            
-            // Send report to Back-Office periodically
-            if (totalProcessed_ % 10 == 0) {
-                sendReport();
-            }
-            
-            // Publish validation response
-            json response = {
-                {"gateId", gateId_},
-                {"ticketId", ticket.getId()},
-                {"valid", valid},
-                {"gateAction", gateAction},
-                {"validationMode", validationMode},
-                {"message", message}
-            };
-            
-            publishResponse(response.dump());
+            uint64_t key = std::hash<std::string>()(ticket.getId());
+            pipeline_.submit(key, [this, ticketBase64 = std::move(ticketBase64), ticket = std::move(ticket),
+                                   signature] {
+                validateTicket(ticketBase64, ticket, signature);
+            });
             
         } catch (const std::exception& e) {
             std::cerr << "✗ Error handling validation request: " << e.what() << std::endl;
         }
     }
 
-    // Online validation via Back-Office REST API
-    bool validateOnline(const std::string& ticketBase64, bool& valid, std::string& message) {
+    // Validate and publish stages, on a pipeline worker
+    void validateTicket(const std::string& ticketBase64, const Ticket& ticket, TicketSigner::Status signature) {
+        // One write per validation so concurrent workers do not interleave
+        std::ostringstream log;
+        log << "\n=== Validation Request [Gate " << gateId_ << "] ===\n";
+        log << "Ticket (Base64): " << ticketBase64.substr(0, 30) << "...\n";
+        log << "Ticket ID: " << ticket.getId() << "\n";
+        log << "Line Number: " << ticket.getLineNumber() << "\n";
+        log << "Validity: " << ticket.getValidityDays() << " days\n";
+        
+        // A verified signature settles it locally, otherwise try online first
+        bool valid = false;
+        std::string validationMode = "online";
+        std::string message;
+        
+        if (signature == TicketSigner::Status::Valid) {
+            valid = !ticket.isExpired();
+            validationMode = "signed";
+            message = valid ? "Valid (signature verified)" : "Expired (signature verified)";
+        } else if (signature == TicketSigner::Status::BadSignature) {
+            validationMode = "signed";
+            message = "Invalid ticket signature";
+        } else if (validateOnline(ticketBase64, ticket, valid, message)) {
+            log << "✓ Online validation successful\n";
+        } else {
+            log << "⚠ Back-Office unavailable - Using offline validation\n";
+            valid = validateOffline(ticket);
+            validationMode = "offline";
+            if (valid) {
+                message = "Valid (offline check - expiry only)";
+            } else {
+                message = signer_.hasKeys() ? "Unsigned ticket refused (offline check)"
+                                            : "Expired (offline check)";
+            }
+        }
+        
+        // Record validation (reported in the background)
+        recordValidation(ticket.getId(), valid, validationMode);
+        
+        // Gate decision
+        std::string gateAction = valid ? "OPEN" : "CLOSED";
+        log << "\n🚪 Gate Action: " << gateAction << "\n";
+        log << "Message: " << message << "\n";
+        std::cout << log.str() << std::flush;
+        
+        // Publish validation response
+        json response = {
+            {"gateId", gateId_},
+            {"ticketId", ticket.getId()},
+            {"valid", valid},
+            {"gateAction", gateAction},
+            {"validationMode", validationMode},
+            {"message", message}
+        };
+        
+        publishResponse(response);
+    }
+
+    // Online validation via Back-Office REST API; a valid verdict is reused
+    // for repeat taps of the same ticket until the cache TTL or its expiry
+    bool validateOnline(const std::string& ticketBase64, const Ticket& ticket, bool& valid, std::string& message) {
+        uint64_t fingerprint = std::hash<std::string>()(ticketBase64);
+        VerdictCache::Verdict verdict;
+        if (verdicts_.lookup(ticket.getId(), fingerprint, CoarseClock::nowMs(), verdict)) {
+            valid = verdict.valid;
+            message = verdict.message;
+            return true;
+        }
+        
         try {
-            httplib::Client client(backOfficeUrl_);
-            client.set_connection_timeout(2, 0);
-            client.set_read_timeout(5, 0);
-            
             json request = {{"ticketBase64", ticketBase64}};
             
-            auto res = client.Post("/api/tickets/validate", 
-                                  request.dump(), 
-                                  "application/json");
+            const char* contentType = PayloadCodec::contentType(restFormat_);
+            auto res = backOffice_.post("/api/tickets/validate", 
+                                        {{"Accept", contentType}},
+                                        PayloadCodec::dump(request, restFormat_), 
+                                        contentType);
             
             if (!res || res->status != 200) {
                 return false; // Back-Office unavailable
             }
             
-            json response = json::parse(res->body);
+            // Older Back-Offices answer JSON whatever was asked for
+            PayloadFormat format = PayloadFormat::Json;
+            PayloadCodec::fromContentType(res->get_header_value("Content-Type"), format);
+            json response = PayloadCodec::parse(res->body, format);
             valid = response["valid"];
             message = response["message"];
             
+            // Only valid verdicts: a ticket refused now may be sold a moment later
+            if (valid) {
+                verdicts_.store(ticket.getId(), fingerprint, {valid, message},
+                                ticket.getExpiryTime() * 1000, CoarseClock::nowMs());
+            }
+            
             return true;
             
         } catch (const std::exception&) {
@@ -228,92 +310,101 @@ private:
         }
     }
 
-    // Offline validation (only checks expiry date as per requirements)
+    // Offline validation (only checks expiry date as per requirements).
+    // Once signing keys are configured, tickets that reach this point carry
+    // no verified signature and could be hand-crafted, so they are refused.
     bool validateOffline(const Ticket& ticket) {
-        return !ticket.isExpired();
+        return !signer_.hasKeys() && !ticket.isExpired();
     }
 
-    // Record validation in history
+    // Count the validation and queue it for the next report
     void recordValidation(const std::string& ticketId, bool valid, const std::string& mode) {
-        totalProcessed_++;
+        ValidationRecord record{};
+        record.setTicketId(ticketId);
+        CoarseClock::formatNow(record.timestamp);
+        record.valid = valid;
+        record.setValidationMode(mode);
         
-        if (valid) {
-            validCount_++;
-        } else {
-            invalidCount_++;
+        (valid ? validCount_ : invalidCount_).fetch_add(1, std::memory_order_relaxed);
+        reports_.add(record);
+    }
+
+    // XML report for the validations since the last one (as per
+    // requirements); built on the reporter thread
+    std::string buildReport(const std::vector<ValidationRecord>& records) {
+        std::stringstream xml;
+        xml << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+        xml << "<GateReport>\n";
+        xml << "  <GateId>" << gateId_ << "</GateId>\n";
+        xml << "  <Timestamp>" << getCurrentTimestamp() << "</Timestamp>\n";
+        
+        uint64_t validCount = validCount_.load(std::memory_order_relaxed);
+        uint64_t invalidCount = invalidCount_.load(std::memory_order_relaxed);
+        xml << "  <Statistics>\n";
+        xml << "    <TotalProcessed>" << validCount + invalidCount << "</TotalProcessed>\n";
+        xml << "    <ValidCount>" << validCount << "</ValidCount>\n";
+        xml << "    <InvalidCount>" << invalidCount << "</InvalidCount>\n";
+        xml << "  </Statistics>\n";
+        
+        xml << "  <RecentValidations>\n";
+        for (const auto& record : records) {
+            xml << "    <Validation>\n";
+            xml << "      <TicketId>" << record.ticketId << "</TicketId>\n";
+            xml << "      <Timestamp>" << record.timestamp << "</Timestamp>\n";
+            xml << "      <Valid>" << (record.valid ? "true" : "false") << "</Valid>\n";
+            xml << "      <Mode>" << record.validationMode << "</Mode>\n";
+            xml << "    </Validation>\n";
         }
+        xml << "  </RecentValidations>\n";
         
-        ValidationRecord record;
-        record.ticketId = ticketId;
-        record.timestamp = getCurrentTimestamp();
-        record.valid = valid;
-        record.validationMode = mode;
+        BackOfficeClient::Stats connections = backOffice_.stats();
+        xml << "  <Connections>\n";
+        xml << "    <Requests>" << connections.requests << "</Requests>\n";
+        xml << "    <Opened>" << connections.connections.created << "</Opened>\n";
+        xml << "    <Reused>" << connections.connections.reused << "</Reused>\n";
+        xml << "    <Reconnects>" << connections.reconnects << "</Reconnects>\n";
+        xml << "  </Connections>\n";
         
-        validationHistory_.push_back(record);
+        VerdictCache::Stats cache = verdicts_.stats();
+        xml << "  <VerdictCache>\n";
+        xml << "    <Hits>" << cache.hits << "</Hits>\n";
+        xml << "    <Misses>" << cache.misses << "</Misses>\n";
+        xml << "    <HitRate>" << static_cast<int>(cache.hitRate() * 100) << "</HitRate>\n";
+        xml << "    <Entries>" << cache.entries << "</Entries>\n";
+        xml << "    <Bytes>" << cache.bytes << "</Bytes>\n";
+        xml << "  </VerdictCache>\n";
+        xml << "</GateReport>\n";
+        return xml.str();
+    }
+    
+    // Send a report to the Back-Office; false makes the shipper retry later
+    bool postReport(const std::string& report) {
+        // Not retried by the client once it may have arrived
+        auto res = backOffice_.post("/api/reports", {}, report, "application/xml");
         
-        // Keep only last 100 records
-        if (validationHistory_.size() > 100) {
-            validationHistory_.erase(validationHistory_.begin());
+        if (!res || res->status != 200) {
+            std::cout << "⚠ Report send failed (Back-Office may be unavailable), will retry" << std::endl;
+            return false;
         }
-    }
-
-    // Send XML report to Back-Office (as per requirements)
-    void sendReport() {
-        try {
-            std::cout << "\nSending report to Back-Office..." << std::endl;
-            
-            // Create XML report
-            std::stringstream xml;
-            xml << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-            xml << "<GateReport>\n";
-            xml << "  <GateId>" << gateId_ << "</GateId>\n";
-            xml << "  <Timestamp>" << getCurrentTimestamp() << "</Timestamp>\n";
-            xml << "  <Statistics>\n";
-            xml << "    <TotalProcessed>" << totalProcessed_ << "</TotalProcessed>\n";
-            xml << "    <ValidCount>" << validCount_ << "</ValidCount>\n";
-            xml << "    <InvalidCount>" << invalidCount_ << "</InvalidCount>\n";
-            xml << "  </Statistics>\n";
-            xml << "  <RecentValidations>\n";
-            
-            // Include last N validations
-            int count = 0;
-            for (auto it = validationHistory_.rbegin(); 
-                 it != validationHistory_.rend() && count < 10; ++it, ++count) {
-                xml << "    <Validation>\n";
-                xml << "      <TicketId>" << it->ticketId << "</TicketId>\n";
-                xml << "      <Timestamp>" << it->timestamp << "</Timestamp>\n";
-                xml << "      <Valid>" << (it->valid ? "true" : "false") << "</Valid>\n";
-                xml << "      <Mode>" << it->validationMode << "</Mode>\n";
-                xml << "    </Validation>\n";
-            }
-            
-            xml << "  </RecentValidations>\n";
-            xml << "</GateReport>\n";
-            
-            // Send to Back-Office
-            httplib::Client client(backOfficeUrl_);
-            client.set_connection_timeout(2, 0);
-            
-            auto res = client.Post("/api/reports", xml.str(), "application/xml");
-            
-            if (res && res->status == 200) {
-                std::cout << "✓ Report sent successfully" << std::endl;
-            } else {
-                std::cout << "⚠ Report send failed (Back-Office may be unavailable)" << std::endl;
-            }
-            
-        } catch (const std::exception& e) {
-            // Silently fail - reporting is not critical
-            std::cout << "⚠ Report send error: " << e.what() << std::endl;
+        
+        BackOfficeClient::Stats connections = backOffice_.stats();
+        std::cout << "✓ Report sent to Back-Office" << std::endl;
+        std::cout << "  Connections: " << connections.connections.created << " opened, "
+                  << static_cast<int>(connections.connections.reuseRate() * 100) << "% reused"
+                  << std::endl;
+        if (verdicts_.enabled()) {
+            std::cout << "  Verdict cache: " << static_cast<int>(verdicts_.stats().hitRate() * 100)
+                      << "% hits" << std::endl;
         }
+        return true;
     }
 
-    void publishResponse(const std::string& payload) {
+    void publishResponse(const json& response) {
         try {
             const std::string TOPIC = "ticket/validation/response";
             const int QOS = 1;
             
-            auto msg = mqtt::make_message(TOPIC, payload);
+            auto msg = mqtt::make_message(TOPIC, PayloadCodec::dump(response, topicFormats_.forTopic(TOPIC)));
             msg->set_qos(QOS);
             mqttClient_.publish(msg)->wait();
             
@@ -336,12 +427,9 @@ private:
         }
     }
 
+    // UTC, ISO 8601; formatted at most once a second
     std::string getCurrentTimestamp() {
-        auto now = std::chrono::system_clock::now();
-        auto time = std::chrono::system_clock::to_time_t(now);
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M:%S");
-        return ss.str();
+        return CoarseClock::formatNow();
     }
 };
 
@@ -354,8 +442,37 @@ int main(int argc, char* argv[]) {
     if (argc > 2) mqttBroker = argv[2];
     if (argc > 3) backOfficeUrl = argv[3];
     
+    // Validations in flight, and queued requests per worker
+    ValidationPipeline::Config pipeline;
+    if (argc > 4) pipeline.workers = static_cast<size_t>(std::max(1, std::atoi(argv[4])));
+    if (argc > 5) pipeline.queueCapacity = static_cast<size_t>(std::max(1, std::atoi(argv[5])));
+    
+    // Report after GATE_REPORT_BATCH validations or GATE_REPORT_INTERVAL seconds
+    ReportShipper::Config reports;
+    if (const char* batch = std::getenv("GATE_REPORT_BATCH")) {
+        reports.batchSize = static_cast<size_t>(std::max(1, std::atoi(batch)));
+    }
+    if (const char* interval = std::getenv("GATE_REPORT_INTERVAL")) {
+        reports.flushInterval = std::chrono::seconds(std::max(1, std::atoi(interval)));
+    }
+    
+    // Online verdict cache: GATE_VERDICT_CACHE_KB of memory, entries kept
+    // GATE_VERDICT_TTL seconds; either set to 0 disables it
+    VerdictCache::Config verdicts;
+    if (const char* kb = std::getenv("GATE_VERDICT_CACHE_KB")) {
+        verdicts.maxBytes = static_cast<size_t>(std::max(0, std::atoi(kb))) * 1024;
+    }
+    if (const char* ttl = std::getenv("GATE_VERDICT_TTL")) {
+        verdicts.ttl = std::chrono::seconds(std::max(0, std::atoi(ttl)));
+    }
+    
+    CoarseClock::start();
+
     try {
-        GateService gate(gateId, mqttBroker, backOfficeUrl);
+        GateService gate(gateId, mqttBroker, backOfficeUrl, TicketSigner::fromEnvironment(),
+                         TopicFormats::fromEnvironment(),
+                         PayloadCodec::fromEnvironment("BACKOFFICE_PAYLOAD_FORMAT"), pipeline,
+                         reports, verdicts);
         gate.start();
     } catch (const std::exception& e) {
         std::cerr << "Fatal error: " << e.what() << std::endl;
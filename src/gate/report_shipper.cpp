@@ -0,0 +1,125 @@
+// src/gate/report_shipper.cpp
+#include "report_shipper.h"
+#include <iostream>
+#include <algorithm>
+#include <exception>
+
+ReportShipper::ReportShipper(Build build, Send send)
+    : ReportShipper(std::move(build), std::move(send), Config()) {
+}
+
+ReportShipper::ReportShipper(Build build, Send send, Config config)
+    : build_(std::move(build)), send_(std::move(send)), config_(config) {
+    config_.batchSize = std::max<size_t>(1, config_.batchSize);
+    config_.maxBuffered = std::max(config_.maxBuffered, config_.batchSize);
+    thread_ = std::thread([this] { run(); });
+}
+
+ReportShipper::~ReportShipper() {
+    stop();
+}
+
+void ReportShipper::add(ValidationRecord record) {
+    // Counted first so the count never drops below the queue's length
+    bool fillsBatch = queued_.fetch_add(1, std::memory_order_relaxed) + 1 == config_.batchSize;
+    queue_.push(std::move(record));
+    if (fillsBatch) {
+        wakeup_.notify_one();
+    }
+}
+
+void ReportShipper::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wakeup_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+ReportShipper::Stats ReportShipper::stats() const {
+    Stats stats;
+    stats.reports = reports_.load(std::memory_order_relaxed);
+    stats.shipped = shipped_.load(std::memory_order_relaxed);
+    stats.failures = failures_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void ReportShipper::run() {
+    std::deque<ValidationRecord> pending;
+    Clock::time_point lastFlush = Clock::now();
+    Clock::time_point retryAt;
+    std::chrono::milliseconds retryDelay = config_.retryDelay;
+    bool retrying = false;
+
+    while (true) {
+        bool stopping = false;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            Clock::time_point deadline = retrying ? retryAt : lastFlush + config_.flushInterval;
+            auto timeout = std::clamp(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()),
+                                      std::chrono::milliseconds(0), kPollInterval);
+            wakeup_.wait_for(lock, timeout, [&] {
+                return stopping_ ||
+                       (!retrying && queued_.load(std::memory_order_relaxed) + pending.size() >= config_.batchSize);
+            });
+            stopping = stopping_;
+        }
+
+        collect(pending);
+        if (stopping) {
+            if (!pending.empty()) ship(pending);
+            return;
+        }
+
+        Clock::time_point now = Clock::now();
+        bool intervalElapsed = now - lastFlush >= config_.flushInterval;
+        if (pending.empty()) {
+            // Nothing to send: the next record waits at most one interval
+            if (intervalElapsed) lastFlush = now;
+            continue;
+        }
+
+        bool due = retrying ? now >= retryAt : (pending.size() >= config_.batchSize || intervalElapsed);
+        if (!due) continue;
+
+        if (ship(pending)) {
+            pending.clear();
+            lastFlush = now;
+            retrying = false;
+            retryDelay = config_.retryDelay;
+        } else {
+            retrying = true;
+            retryAt = now + retryDelay;
+            retryDelay = std::min(retryDelay * 2, config_.maxRetryDelay);
+        }
+    }
+}
+
+void ReportShipper::collect(std::deque<ValidationRecord>& pending) {
+    ValidationRecord record;
+    while (queue_.tryPop(record)) {
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        pending.push_back(std::move(record));
+        if (pending.size() > config_.maxBuffered) {
+            pending.pop_front();
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+bool ReportShipper::ship(const std::deque<ValidationRecord>& pending) {
+    try {
+        std::vector<ValidationRecord> records(pending.begin(), pending.end());
+        if (send_(build_(records))) {
+            reports_.fetch_add(1, std::memory_order_relaxed);
+            shipped_.fetch_add(records.size(), std::memory_order_relaxed);
+            return true;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "⚠ Report error: " << e.what() << std::endl;
+    }
+    failures_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
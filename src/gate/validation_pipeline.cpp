@@ -0,0 +1,90 @@
+// src/gate/validation_pipeline.cpp
+#include "validation_pipeline.h"
+#include <iostream>
+#include <algorithm>
+#include <exception>
+
+ValidationPipeline::ValidationPipeline() : ValidationPipeline(Config()) {
+}
+
+ValidationPipeline::ValidationPipeline(Config config) : config_(config) {
+    config_.workers = std::max<size_t>(1, config_.workers);
+    config_.queueCapacity = std::max<size_t>(1, config_.queueCapacity);
+
+    lanes_.reserve(config_.workers);
+    for (size_t i = 0; i < config_.workers; i++) {
+        lanes_.push_back(std::make_unique<Lane>());
+    }
+    for (auto& lane : lanes_) {
+        Lane* target = lane.get();
+        lane->thread = std::thread([this, target] { run(*target); });
+    }
+}
+
+ValidationPipeline::~ValidationPipeline() {
+    stop();
+}
+
+bool ValidationPipeline::submit(uint64_t key, Task task) {
+    Lane& lane = *lanes_[key % lanes_.size()];
+    std::unique_lock<std::mutex> lock(lane.mutex);
+
+    if (!lane.stopping && lane.tasks.size() >= config_.queueCapacity) {
+        stalls_.fetch_add(1, std::memory_order_relaxed);
+        lane.notFull.wait(lock, [&] { return lane.stopping || lane.tasks.size() < config_.queueCapacity; });
+    }
+    if (lane.stopping) {
+        return false;
+    }
+
+    lane.tasks.push_back(std::move(task));
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+    lock.unlock();
+    lane.notEmpty.notify_one();
+    return true;
+}
+
+void ValidationPipeline::stop() {
+    for (auto& lane : lanes_) {
+        {
+            std::lock_guard<std::mutex> lock(lane->mutex);
+            lane->stopping = true;
+        }
+        lane->notEmpty.notify_all();
+        lane->notFull.notify_all();
+    }
+    for (auto& lane : lanes_) {
+        if (lane->thread.joinable()) lane->thread.join();
+    }
+}
+
+ValidationPipeline::Stats ValidationPipeline::stats() const {
+    Stats stats;
+    stats.submitted = submitted_.load(std::memory_order_relaxed);
+    stats.completed = completed_.load(std::memory_order_relaxed);
+    stats.stalls = stalls_.load(std::memory_order_relaxed);
+    stats.queued = static_cast<size_t>(stats.submitted - stats.completed);
+    return stats;
+}
+
+void ValidationPipeline::run(Lane& lane) {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(lane.mutex);
+            lane.notEmpty.wait(lock, [&] { return lane.stopping || !lane.tasks.empty(); });
+            if (lane.tasks.empty()) return;  // Stopping and drained
+
+            task = std::move(lane.tasks.front());
+            lane.tasks.pop_front();
+        }
+        lane.notFull.notify_one();
+
+        try {
+            task();
+        } catch (const std::exception& e) {
+            std::cerr << "✗ Validation task failed: " << e.what() << std::endl;
+        }
+        completed_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,86 @@
+// src/gate/verdict_cache.cpp
+#include "verdict_cache.h"
+#include <algorithm>
+
+VerdictCache::VerdictCache() : VerdictCache(Config()) {
+}
+
+VerdictCache::VerdictCache(Config config) : config_(config) {
+}
+
+bool VerdictCache::lookup(const std::string& ticketId, uint64_t fingerprint, int64_t nowMs, Verdict& verdict) {
+    if (!enabled()) return false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = index_.find(ticketId);
+    if (found == index_.end()) {
+        misses_++;
+        return false;
+    }
+
+    Lru::iterator it = found->second;
+    if (it->fingerprint != fingerprint || nowMs >= it->expiresAtMs) {
+        erase(it);
+        misses_++;
+        return false;
+    }
+
+    lru_.splice(lru_.begin(), lru_, it);
+    verdict = it->verdict;
+    hits_++;
+    return true;
+}
+
+void VerdictCache::store(const std::string& ticketId, uint64_t fingerprint, const Verdict& verdict,
+                         int64_t ticketExpiryMs, int64_t nowMs) {
+    if (!enabled()) return;
+
+    int64_t expiresAtMs = std::min<int64_t>(nowMs + config_.ttl.count(), ticketExpiryMs);
+    if (expiresAtMs <= nowMs) return;
+
+    Entry entry{ticketId, fingerprint, verdict, expiresAtMs, 0};
+    entry.bytes = footprint(entry);
+    if (entry.bytes > config_.maxBytes) return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = index_.find(ticketId);
+    if (found != index_.end()) erase(found->second);
+
+    lru_.push_front(std::move(entry));
+    index_.emplace(lru_.front().ticketId, lru_.begin());
+    bytes_ += lru_.front().bytes;
+
+    while (bytes_ > config_.maxBytes) {
+        erase(std::prev(lru_.end()));
+        evictions_++;
+    }
+}
+
+VerdictCache::Stats VerdictCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.evictions = evictions_;
+    stats.entries = lru_.size();
+    stats.bytes = bytes_;
+    return stats;
+}
+
+// Estimate: the entry and its strings, its list node (two links) and its
+// hash node (key view, iterator, next link, cached hash) plus a bucket
+size_t VerdictCache::footprint(const Entry& entry) {
+    // Strings up to 15 characters are stored inline by every common library
+    size_t strings = 0;
+    if (entry.ticketId.size() > 15) strings += entry.ticketId.capacity() + 1;
+    if (entry.verdict.message.size() > 15) strings += entry.verdict.message.capacity() + 1;
+    size_t listNode = sizeof(Entry) + 2 * sizeof(void*);
+    size_t hashNode = sizeof(std::string_view) + sizeof(Lru::iterator) + 2 * sizeof(void*) + sizeof(size_t);
+    return listNode + hashNode + sizeof(void*) + strings;
+}
+
+void VerdictCache::erase(Lru::iterator it) {
+    bytes_ -= it->bytes;
+    index_.erase(it->ticketId);
+    lru_.erase(it);
+}
@@ -0,0 +1,145 @@
+// src/ticketconv/main.cpp
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <stdexcept>
+#include <utility>
+#include <chrono>
+#include "ticket.h"
+#include "ticket_codec.h"
+#include "ticket_csv.h"
+#include "csv_ticket_loader.h"
+#include "ticket_snapshot.h"
+
+/**
+ * @brief Ticket stock converter
+ *
+ * Converts between the CSV stock file (TicketID,CreationDate,ValidityDays,
+ * LineNumber) and the memory-mapped binary snapshot used for fast
+ * back-office startup, and imports/exports Base64 tickets (one per line,
+ * as issued to passengers) in bulk.
+ */
+static void printUsage(const char* program) {
+    std::cerr << "Usage:" << std::endl;
+    std::cerr << "  " << program << " to-binary <tickets.csv> <tickets.bin>" << std::endl;
+    std::cerr << "  " << program << " to-csv <tickets.bin> <tickets.csv>" << std::endl;
+    std::cerr << "  " << program << " to-base64 <tickets.csv> <tickets.b64>" << std::endl;
+    std::cerr << "  " << program << " from-base64 <tickets.b64> <tickets.csv>" << std::endl;
+}
+
+static std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+static void exportBase64(const std::vector<Ticket>& tickets, const std::string& path) {
+    std::string encoded;
+    std::vector<size_t> ends;
+    TicketCodec::encodeMany(tickets, encoded, ends);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    size_t begin = 0;
+    for (size_t end : ends) {
+        file.write(encoded.data() + begin, static_cast<std::streamsize>(end - begin));
+        file.put('\n');
+        begin = end;
+    }
+    if (!file.flush()) {
+        throw std::runtime_error("Cannot write " + path);
+    }
+}
+
+// Decode every non-empty line; bad lines are reported and skipped
+static void importBase64(const std::string& text, std::vector<Ticket>& tickets) {
+    std::vector<std::string_view> lines;
+    std::string_view rest(text);
+    while (!rest.empty()) {
+        size_t newline = rest.find('\n');
+        std::string_view line = rest.substr(0, newline);
+        rest.remove_prefix(newline == std::string_view::npos ? rest.size() : newline + 1);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (!line.empty()) lines.push_back(line);
+    }
+
+    std::vector<Ticket> decoded;
+    std::vector<TicketCodec::Status> statuses;
+    size_t good = TicketCodec::decodeMany(lines, decoded, statuses);
+
+    tickets.reserve(good);
+    for (size_t i = 0; i < lines.size(); i++) {
+        if (statuses[i] == TicketCodec::Status::Ok) {
+            tickets.push_back(std::move(decoded[i]));
+        } else {
+            std::cerr << "⚠ Ticket " << i + 1 << ": " << TicketCodec::statusName(statuses[i]) << std::endl;
+        }
+    }
+    std::cout << "Decoded " << good << " of " << lines.size() << " tickets" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 4) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::string command = argv[1];
+    std::string input = argv[2];
+    std::string output = argv[3];
+    auto started = std::chrono::steady_clock::now();
+    std::vector<Ticket> tickets;
+
+    try {
+        if (command == "to-binary") {
+            CsvTicketLoader loader;
+            CsvTicketLoader::Stats stats;
+            if (!loader.load(input, tickets, stats)) {
+                std::cerr << "✗ Cannot open " << input << std::endl;
+                return 1;
+            }
+            std::cout << "Parsed " << stats.rows << " rows ("
+                      << static_cast<long long>(stats.rowsPerSecond()) << " rows/s)" << std::endl;
+            if (stats.badRows > 0) {
+                std::cerr << "⚠ Skipped " << stats.badRows << " malformed rows" << std::endl;
+            }
+            TicketSnapshot::write(output, tickets);
+        } else if (command == "to-csv") {
+            TicketSnapshot snapshot(input);
+            tickets.reserve(snapshot.size());
+            for (size_t i = 0; i < snapshot.size(); i++) {
+                tickets.push_back(snapshot.ticket(i));
+            }
+            TicketCsv::writeFile(output, tickets);
+        } else if (command == "to-base64") {
+            CsvTicketLoader loader;
+            CsvTicketLoader::Stats stats;
+            if (!loader.load(input, tickets, stats)) {
+                std::cerr << "✗ Cannot open " << input << std::endl;
+                return 1;
+            }
+            exportBase64(tickets, output);
+        } else if (command == "from-base64") {
+            importBase64(readFile(input), tickets);
+            TicketCsv::writeFile(output, tickets);
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "✗ Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - started);
+    std::cout << "✓ Converted " << tickets.size() << " tickets to " << output
+              << " in " << elapsed.count() << " ms" << std::endl;
+    return 0;
+}
@@ -5,6 +5,8 @@
 #include <mqtt/async_client.h>
 #include <thread>
 #include <chrono>
+#include <utility>
+#include "payload_codec.h"
 
 using json = nlohmann::json;
 
@@ -16,13 +18,20 @@ using json = nlohmann::json;
  * 2. Sends request to Back-Office via REST API
  * 3. Back-Office creates ticket and responds with Base64 data
  * 4. Publishes result to MQTT (ticket/sale/response)
+ *
+ * MQTT payloads are JSON unless MQTT_PAYLOAD_FORMATS selects CBOR or
+ * MessagePack for a topic; BACKOFFICE_PAYLOAD_FORMAT does the same for
+ * the REST calls (see PayloadCodec).
  */
 class TVMService {
 public:
     TVMService(const std::string& mqttBroker, const std::string& clientId, 
-               const std::string& backOfficeUrl)
+               const std::string& backOfficeUrl, TopicFormats topicFormats = {},
+               PayloadFormat restFormat = PayloadFormat::Json)
         : mqttClient_(mqttBroker, clientId),
           backOfficeUrl_(backOfficeUrl),
+          topicFormats_(std::move(topicFormats)),
+          restFormat_(restFormat),
           running_(true) {
     }
 
@@ -36,6 +45,8 @@ public:
         std::cout << "╚════════════════════════════════════════╝" << std::endl;
         std::cout << "MQTT Broker: " << mqttClient_.get_server_uri() << std::endl;
         std::cout << "Back-Office: " << backOfficeUrl_ << std::endl;
+        std::cout << "Payload Formats: MQTT " << topicFormats_.describe()
+                  << ", REST " << PayloadCodec::name(restFormat_) << std::endl;
         std::cout << "----------------------------------------" << std::endl;
         
         // Connect to MQTT broker
@@ -56,6 +67,8 @@ public:
 private:
     mqtt::async_client mqttClient_;
     std::string backOfficeUrl_;
+    TopicFormats topicFormats_;
+    PayloadFormat restFormat_;
     bool running_;
 
     void connectMQTT() {
@@ -109,20 +122,20 @@ private:
                     break;
                 }
                 
-                handleSaleRequest(msg->to_string());
+                handleSaleRequest(msg->get_topic(), msg->to_string());
             }
         } catch (const mqtt::exception& exc) {
             std::cerr << "✗ Consume error: " << exc.what() << std::endl;
         }
     }
 
-    void handleSaleRequest(const std::string& payload) {
+    void handleSaleRequest(const std::string& topic, const std::string& payload) {
         try {
             std::cout << "\n=== New Sale Request ===" << std::endl;
-            std::cout << "Payload: " << payload << std::endl;
             
             // Parse MQTT message
-            json request = json::parse(payload);
+            json request = PayloadCodec::parse(payload, topicFormats_.forTopic(topic));
+            std::cout << "Payload: " << request.dump() << std::endl;
             int validityDays = request["validityDays"];
             int lineNumber = request["lineNumber"];
             
@@ -142,9 +155,11 @@ private:
             client.set_connection_timeout(5, 0);
             client.set_read_timeout(10, 0);
             
+            const char* contentType = PayloadCodec::contentType(restFormat_);
             auto res = client.Post("/api/tickets/create", 
-                                  backOfficeRequest.dump(), 
-                                  "application/json");
+                                  {{"Accept", contentType}},
+                                  PayloadCodec::dump(backOfficeRequest, restFormat_), 
+                                  contentType);
             
             if (!res) {
                 std::cerr << "✗ Failed to connect to Back-Office" << std::endl;
@@ -153,7 +168,7 @@ private:
             }
             
             if (res->status == 200) {
-                json response = json::parse(res->body);
+                json response = parseResponse(*res);
                 
                 std::cout << "\n✓ Ticket created successfully!" << std::endl;
                 std::cout << "Ticket ID: " << response["ticketId"] << std::endl;
@@ -166,7 +181,7 @@ private:
                     {"ticketBase64", response["ticketBase64"]}
                 };
                 
-                publishResponse(ticketResponse.dump());
+                publishResponse(ticketResponse);
                 
             } else {
                 std::cerr << "✗ Back-Office error: " << res->status << " - " << res->body << std::endl;
@@ -179,12 +194,20 @@ private:
         }
     }
 
-    void publishResponse(const std::string& payload) {
+    // The Back-Office answers in the format asked for, but older versions
+    // only speak JSON
+    json parseResponse(const httplib::Response& res) const {
+        PayloadFormat format = PayloadFormat::Json;
+        PayloadCodec::fromContentType(res.get_header_value("Content-Type"), format);
+        return PayloadCodec::parse(res.body, format);
+    }
+
+    void publishResponse(const json& response) {
         try {
             const std::string TOPIC = "ticket/sale/response";
             const int QOS = 1;
             
-            auto msg = mqtt::make_message(TOPIC, payload);
+            auto msg = mqtt::make_message(TOPIC, PayloadCodec::dump(response, topicFormats_.forTopic(TOPIC)));
             msg->set_qos(QOS);
             mqttClient_.publish(msg)->wait();
             
@@ -200,7 +223,7 @@ private:
             {"status", "error"},
             {"message", errorMsg}
         };
-        publishResponse(errorResponse.dump());
+        publishResponse(errorResponse);
     }
 
     void disconnect() {
@@ -225,7 +248,8 @@ int main(int argc, char* argv[]) {
     if (argc > 2) backOfficeUrl = argv[2];
     
     try {
-        TVMService tvm(mqttBroker, "TVM-001", backOfficeUrl);
+        TVMService tvm(mqttBroker, "TVM-001", backOfficeUrl, TopicFormats::fromEnvironment(),
+                       PayloadCodec::fromEnvironment("BACKOFFICE_PAYLOAD_FORMAT"));
         tvm.start();
     } catch (const std::exception& e) {
         std::cerr << "Fatal error: " << e.what() << std::endl;
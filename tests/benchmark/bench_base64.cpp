@@ -0,0 +1,142 @@
+// tests/benchmark/bench_base64.cpp
+// Base64: scalar / SSSE3 / AVX2 codec vs. the former Ticket implementation
+//
+// Run: ./bench_base64 --benchmark_filter=Decode
+// Sizes cover a binary ticket (24 bytes), a JSON ticket (~110 bytes) and
+// bulk payloads.
+
+#include <benchmark/benchmark.h>
+#include "base64.h"
+#include <string>
+#include <vector>
+#include <random>
+
+namespace {
+
+static const char legacyChars[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+    "abcdefghijklmnopqrstuvwxyz"
+    "0123456789+/";
+
+// Ticket::base64Encode before the codec was introduced
+std::string legacyEncode(const std::string& input) {
+    std::string output;
+    int val = 0;
+    int valb = -6;
+
+    for (unsigned char c : input) {
+        val = (val << 8) + c;
+        valb += 8;
+        while (valb >= 0) {
+            output.push_back(legacyChars[(val >> valb) & 0x3F]);
+            valb -= 6;
+        }
+    }
+    if (valb > -6) {
+        output.push_back(legacyChars[((val << 8) >> (valb + 8)) & 0x3F]);
+    }
+    while (output.size() % 4) {
+        output.push_back('=');
+    }
+    return output;
+}
+
+// Ticket::base64Decode before the codec was introduced
+std::string legacyDecode(const std::string& input) {
+    std::string output;
+    std::vector<int> T(256, -1);
+    for (int i = 0; i < 64; i++) {
+        T[legacyChars[i]] = i;
+    }
+
+    int val = 0;
+    int valb = -8;
+    for (unsigned char c : input) {
+        if (T[c] == -1) break;
+        val = (val << 6) + T[c];
+        valb += 6;
+        if (valb >= 0) {
+            output.push_back(char((val >> valb) & 0xFF));
+            valb -= 8;
+        }
+    }
+    return output;
+}
+
+std::string randomBytes(size_t size) {
+    std::mt19937 gen(42);
+    std::string bytes(size, '\0');
+    for (auto& c : bytes) c = static_cast<char>(gen() & 0xFF);
+    return bytes;
+}
+
+// Selects the kernel set for one benchmark run; skipped when unsupported
+bool useIsa(benchmark::State& state, Base64::Isa isa) {
+    if (!Base64::supported(isa)) {
+        state.SkipWithError("instruction set not supported");
+        return false;
+    }
+    Base64::setIsa(isa);
+    state.SetLabel(Base64::isaName(isa));
+    return true;
+}
+
+} // namespace
+
+static void BM_LegacyEncode(benchmark::State& state) {
+    std::string data = randomBytes(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(legacyEncode(data));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LegacyEncode)->Arg(24)->Arg(110)->Arg(4096)->Arg(1 << 20);
+
+static void BM_LegacyDecode(benchmark::State& state) {
+    std::string text = legacyEncode(randomBytes(static_cast<size_t>(state.range(0))));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(legacyDecode(text));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LegacyDecode)->Arg(24)->Arg(110)->Arg(4096)->Arg(1 << 20);
+
+static void BM_Encode(benchmark::State& state) {
+    if (!useIsa(state, static_cast<Base64::Isa>(state.range(1)))) return;
+    std::string data = randomBytes(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Base64::encode(data));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Encode)->ArgsProduct({{24, 110, 4096, 1 << 20}, {0, 1, 2}});
+
+static void BM_Decode(benchmark::State& state) {
+    if (!useIsa(state, static_cast<Base64::Isa>(state.range(1)))) return;
+    std::string text = Base64::encode(randomBytes(static_cast<size_t>(state.range(0))));
+    std::string out;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Base64::decode(text, out));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Decode)->ArgsProduct({{24, 110, 4096, 1 << 20}, {0, 1, 2}});
+
+// Decode into a caller-owned buffer: no allocation at all
+static void BM_DecodeInPlace(benchmark::State& state) {
+    if (!useIsa(state, static_cast<Base64::Isa>(state.range(1)))) return;
+    std::string text = Base64::encode(randomBytes(static_cast<size_t>(state.range(0))));
+    std::vector<char> out(Base64::maxDecodedSize(text.size()));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Base64::decode(text.data(), text.size(), out.data()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DecodeInPlace)->ArgsProduct({{24, 110, 4096, 1 << 20}, {0, 1, 2}});
+
+BENCHMARK_MAIN();
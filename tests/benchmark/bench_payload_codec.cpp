@@ -0,0 +1,87 @@
+// tests/benchmark/bench_payload_codec.cpp
+// REST / MQTT payloads: text JSON vs. CBOR vs. MessagePack
+//
+// Run: ./bench_payload_codec --benchmark_filter=Parse
+// Argument 0 selects the format (0 = JSON, 1 = CBOR, 2 = MessagePack); the
+// label shows the encoded size.
+
+#include <benchmark/benchmark.h>
+#include "payload_codec.h"
+#include <nlohmann/json.hpp>
+#include <string>
+
+using json = nlohmann::json;
+
+namespace {
+
+// Gate -> Back-Office validation request
+json validationRequest() {
+    return {{"ticketBase64", "ATEHACoAAAA5MAAAAAAAACh9mmUAAAAAYCbadmJsybIq8P39"}};
+}
+
+// Gate response published on ticket/validation/response
+json validationResponse() {
+    return {
+        {"gateId", "001"},
+        {"ticketId", "0C5Q8M1B00G00"},
+        {"valid", true},
+        {"gateAction", "OPEN"},
+        {"validationMode", "signed"},
+        {"message", "Valid (signature verified)"}
+    };
+}
+
+// Batch validation result for 100 tickets
+json batchResponse() {
+    json results = json::array();
+    for (int i = 0; i < 100; i++) {
+        results.push_back({
+            {"valid", true},
+            {"message", "Ticket is valid"},
+            {"ticketId", "0C5Q8M1B00G" + std::to_string(10 + i)},
+            {"lineNumber", i % 12}
+        });
+    }
+    return {{"success", true}, {"count", 100}, {"validCount", 100}, {"results", results}};
+}
+
+json sample(int64_t kind) {
+    switch (kind) {
+    case 0: return validationRequest();
+    case 1: return validationResponse();
+    default: return batchResponse();
+    }
+}
+
+PayloadFormat formatArg(benchmark::State& state) {
+    return static_cast<PayloadFormat>(state.range(0));
+}
+
+} // namespace
+
+static void BM_Dump(benchmark::State& state) {
+    PayloadFormat format = formatArg(state);
+    json value = sample(state.range(1));
+    size_t size = PayloadCodec::dump(value, format).size();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PayloadCodec::dump(value, format));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+    state.SetLabel(std::string(PayloadCodec::name(format)) + " " + std::to_string(size) + " B");
+}
+BENCHMARK(BM_Dump)->ArgsProduct({{0, 1, 2}, {0, 1, 2}});
+
+static void BM_Parse(benchmark::State& state) {
+    PayloadFormat format = formatArg(state);
+    std::string payload = PayloadCodec::dump(sample(state.range(1)), format);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PayloadCodec::parse(payload, format));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payload.size()));
+    state.SetLabel(std::string(PayloadCodec::name(format)) + " " + std::to_string(payload.size()) + " B");
+}
+BENCHMARK(BM_Parse)->ArgsProduct({{0, 1, 2}, {0, 1, 2}});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,162 @@
+// tests/benchmark/bench_ticket.cpp
+// Ticket serialization: JSON, Base64, expiry check and CSV rows
+//
+// Run: ./bench_ticket --benchmark_filter=Base64
+// or:  cmake --build build --target run_benchmarks  (JSON results in
+//      build/benchmarks/)
+// Argument 0 is the ticket ID length: 13 is a Snowflake ID (binary wire
+// format), longer IDs are legacy IDs (JSON payload).
+
+#include <benchmark/benchmark.h>
+#include "ticket.h"
+#include "ticket_id.h"
+#include "ticket_csv.h"
+#include "coarse_clock.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int64_t kCreationTime = 1704623400;  // 2024-01-07T10:30:00Z
+
+// Snowflake ID for length 13, otherwise a legacy ID padded to length
+std::string idOfLength(size_t length) {
+    std::string id = TicketIdAllocator::encode(uint64_t{0x1234567890ABCDEF} >> 1);
+    if (length == id.size()) return id;
+
+    id = "TKT-1-1736335200";
+    id.resize(length, 'X');
+    return id;
+}
+
+Ticket sampleTicket(benchmark::State& state) {
+    std::string id = idOfLength(static_cast<size_t>(state.range(0)));
+    state.SetLabel(TicketRecord::packId(id) != TicketRecord::kLegacyId ? "snowflake" : "legacy");
+    return Ticket(id, kCreationTime, 30, 7);
+}
+
+void idLengths(benchmark::internal::Benchmark* bench) {
+    bench->Arg(13)->Arg(16)->Arg(36)->Arg(64);
+}
+
+} // namespace
+
+// ============================================================================
+// JSON
+// ============================================================================
+
+static void BM_ToJson(benchmark::State& state) {
+    Ticket ticket = sampleTicket(state);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ticket.toJson());
+    }
+}
+BENCHMARK(BM_ToJson)->Apply(idLengths);
+
+static void BM_FromJson(benchmark::State& state) {
+    std::string text = sampleTicket(state).toJson();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Ticket::fromJson(text));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_FromJson)->Apply(idLengths);
+
+// ============================================================================
+// BASE64
+// ============================================================================
+
+static void BM_ToBase64(benchmark::State& state) {
+    Ticket ticket = sampleTicket(state);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ticket.toBase64());
+    }
+}
+BENCHMARK(BM_ToBase64)->Apply(idLengths);
+
+// Appending into a reused buffer, as the batch endpoints do
+static void BM_AppendBase64(benchmark::State& state) {
+    Ticket ticket = sampleTicket(state);
+    std::string out;
+    std::string scratch;
+
+    for (auto _ : state) {
+        out.clear();
+        ticket.appendBase64(out, scratch);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(BM_AppendBase64)->Apply(idLengths);
+
+static void BM_FromBase64(benchmark::State& state) {
+    std::string text = sampleTicket(state).toBase64();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Ticket::fromBase64(text));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_FromBase64)->Apply(idLengths);
+
+// Decoding into a reused ticket, as the gate does
+static void BM_TryFromBase64(benchmark::State& state) {
+    std::string text = sampleTicket(state).toBase64();
+    Ticket ticket;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Ticket::tryFromBase64(text, ticket));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_TryFromBase64)->Apply(idLengths);
+
+// ============================================================================
+// EXPIRY
+// ============================================================================
+
+// Arg 1: clock refresh thread running (cached load) or not (system clock)
+static void BM_IsExpired(benchmark::State& state) {
+    Ticket ticket(idOfLength(13), kCreationTime, 30, 7);
+    if (state.range(0)) {
+        CoarseClock::start();
+        state.SetLabel("coarse clock");
+    } else {
+        CoarseClock::stop();
+        state.SetLabel("system clock");
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ticket.isExpired());
+    }
+    CoarseClock::stop();
+}
+BENCHMARK(BM_IsExpired)->Arg(0)->Arg(1);
+
+// ============================================================================
+// CSV
+// ============================================================================
+
+static void BM_CsvFormatRow(benchmark::State& state) {
+    Ticket ticket = sampleTicket(state);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TicketCsv::formatRow(ticket));
+    }
+}
+BENCHMARK(BM_CsvFormatRow)->Apply(idLengths);
+
+static void BM_CsvParseRow(benchmark::State& state) {
+    std::string line = TicketCsv::formatRow(sampleTicket(state));
+    TicketCsv::Row row;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TicketCsv::parseRow(line, row));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(line.size()));
+}
+BENCHMARK(BM_CsvParseRow)->Apply(idLengths);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,108 @@
+// tests/benchmark/bench_ticket_index.cpp
+// Ticket ID lookup: the store's hash index vs. the former linear scan
+//
+// Run: ./bench_ticket_index --benchmark_filter=Store
+// Lookup time should stay flat from 10k to 10M tickets.
+
+#include <benchmark/benchmark.h>
+#include "ticket_store.h"
+#include "ticket_id.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include <random>
+
+namespace {
+
+// Largest store the linear scan baseline runs against
+constexpr size_t kMaxScanned = 100000;
+
+/**
+ * Store of N Snowflake-ID tickets, looked up through TicketStore::find as
+ * validation does; rebuilt only when N changes so the 10M case is
+ * generated once per benchmark family.
+ */
+struct StoredIds {
+    size_t size = 0;
+    TicketStore store;
+    std::vector<std::string> ids;  // Only kept for the linear scan
+    std::vector<std::string> hits;
+    std::vector<std::string> misses;
+
+    static const StoredIds& forSize(size_t n) {
+        static std::unique_ptr<StoredIds> cached;
+        if (!cached || cached->size != n) {
+            cached = std::make_unique<StoredIds>();
+            cached->build(n);
+        }
+        return *cached;
+    }
+
+    void build(size_t n) {
+        size = n;
+        store.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            std::string id = TicketIdAllocator::encode(i + 1);
+            store.insert(Ticket(id, 1704623400, 7, 1));
+            if (n <= kMaxScanned) ids.push_back(std::move(id));
+        }
+
+        std::mt19937_64 gen(42);
+        std::uniform_int_distribution<size_t> dis(0, n - 1);
+        for (int i = 0; i < 4096; i++) {
+            hits.push_back(TicketIdAllocator::encode(dis(gen) + 1));
+            misses.push_back(TicketIdAllocator::encode(n + 1 + dis(gen)));
+        }
+    }
+};
+
+} // namespace
+
+static void BM_StoreLookupHit(benchmark::State& state) {
+    const StoredIds& stored = StoredIds::forSize(static_cast<size_t>(state.range(0)));
+    TicketRecord record;
+    size_t i = 0;
+
+    for (auto _ : state) {
+        bool found = stored.store.find(stored.hits[i++ & 4095], record);
+        benchmark::DoNotOptimize(found);
+        benchmark::DoNotOptimize(record);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StoreLookupHit)->RangeMultiplier(10)->Range(10000, 10000000);
+
+static void BM_StoreLookupMiss(benchmark::State& state) {
+    const StoredIds& stored = StoredIds::forSize(static_cast<size_t>(state.range(0)));
+    TicketRecord record;
+    size_t i = 0;
+
+    for (auto _ : state) {
+        bool found = stored.store.find(stored.misses[i++ & 4095], record);
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StoreLookupMiss)->RangeMultiplier(10)->Range(10000, 10000000);
+
+// Baseline: the scan handleTicketValidation used before the index
+static void BM_LinearScanHit(benchmark::State& state) {
+    const StoredIds& stored = StoredIds::forSize(static_cast<size_t>(state.range(0)));
+    size_t i = 0;
+
+    for (auto _ : state) {
+        const std::string& id = stored.hits[i++ & 4095];
+        bool exists = false;
+        for (const auto& candidate : stored.ids) {
+            if (candidate == id) {
+                exists = true;
+                break;
+            }
+        }
+        benchmark::DoNotOptimize(exists);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LinearScanHit)->RangeMultiplier(10)->Range(10000, kMaxScanned);
+
+BENCHMARK_MAIN();
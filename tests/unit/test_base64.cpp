@@ -0,0 +1,158 @@
+// tests/unit/test_base64.cpp
+// Unit tests for the Base64 codec (scalar and SIMD kernels)
+
+#include <gtest/gtest.h>
+#include "base64.h"
+#include <random>
+#include <string>
+#include <vector>
+
+using Variant = Base64::Variant;
+using Isa = Base64::Isa;
+
+/**
+ * Runs every test once per kernel set supported by this CPU
+ */
+class Base64Test : public ::testing::TestWithParam<Isa> {
+protected:
+    void SetUp() override {
+        if (!Base64::supported(GetParam())) {
+            GTEST_SKIP() << Base64::isaName(GetParam()) << " not supported on this CPU";
+        }
+        previous_ = Base64::isa();
+        Base64::setIsa(GetParam());
+    }
+
+    void TearDown() override {
+        Base64::setIsa(previous_);
+    }
+
+    static std::string randomBytes(size_t size, uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::string bytes(size, '\0');
+        for (auto& c : bytes) c = static_cast<char>(gen() & 0xFF);
+        return bytes;
+    }
+
+    // Straightforward reference encoder
+    static std::string reference(const std::string& data, Variant variant) {
+        const char* alphabet = variant == Variant::Standard
+            ? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"
+            : "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+        std::string out;
+        uint32_t bits = 0;
+        int count = 0;
+        for (unsigned char c : data) {
+            bits = (bits << 8) | c;
+            count += 8;
+            while (count >= 6) {
+                out += alphabet[(bits >> (count - 6)) & 0x3F];
+                count -= 6;
+            }
+        }
+        if (count > 0) out += alphabet[(bits << (6 - count)) & 0x3F];
+        if (variant == Variant::Standard) {
+            while (out.size() % 4) out += '=';
+        }
+        return out;
+    }
+
+private:
+    Isa previous_ = Isa::Scalar;
+};
+
+// ============================================================================
+// ENCODING / DECODING
+// ============================================================================
+
+TEST_P(Base64Test, KnownVectors) {
+    EXPECT_EQ(Base64::encode(""), "");
+    EXPECT_EQ(Base64::encode("f"), "Zg==");
+    EXPECT_EQ(Base64::encode("fo"), "Zm8=");
+    EXPECT_EQ(Base64::encode("foo"), "Zm9v");
+    EXPECT_EQ(Base64::encode("foobar"), "Zm9vYmFy");
+    EXPECT_EQ(Base64::encode("fo", Variant::Url), "Zm8");
+
+    std::string out;
+    ASSERT_TRUE(Base64::decode("Zm9vYg==", out));
+    EXPECT_EQ(out, "foob");
+    ASSERT_TRUE(Base64::decode("Zm9vYg", out));
+    EXPECT_EQ(out, "foob");
+}
+
+TEST_P(Base64Test, MatchesReferenceForAllSizes) {
+    for (Variant variant : {Variant::Standard, Variant::Url}) {
+        for (size_t size = 0; size < 300; size++) {
+            std::string data = randomBytes(size, static_cast<uint32_t>(size));
+            std::string encoded = Base64::encode(data, variant);
+            ASSERT_EQ(encoded, reference(data, variant)) << "size " << size;
+            ASSERT_EQ(encoded.size(), Base64::encodedSize(size, variant));
+
+            std::string decoded;
+            ASSERT_TRUE(Base64::decode(encoded, decoded, variant)) << "size " << size;
+            ASSERT_EQ(decoded, data) << "size " << size;
+        }
+    }
+}
+
+TEST_P(Base64Test, EveryByteValueRoundTrips) {
+    std::string data;
+    for (int i = 0; i < 256; i++) data += static_cast<char>(i);
+    data += data;
+
+    std::string decoded;
+    ASSERT_TRUE(Base64::decode(Base64::encode(data), decoded));
+    EXPECT_EQ(decoded, data);
+}
+
+TEST_P(Base64Test, InvalidCharacterDetectedAtAnyPosition) {
+    std::string encoded = Base64::encode(randomBytes(120, 7));
+    std::string decoded;
+
+    for (size_t pos = 0; pos < encoded.size() - 2; pos++) {
+        for (char bad : {'!', '-', '_', ' ', '\n', '=', '\x80', '\xff', '\0'}) {
+            std::string corrupt = encoded;
+            corrupt[pos] = bad;
+            ASSERT_FALSE(Base64::decode(corrupt, decoded)) << "position " << pos << " char " << int(bad);
+        }
+    }
+}
+
+TEST_P(Base64Test, AlphabetsDoNotMix) {
+    std::string data = randomBytes(90, 3);
+    std::string standard = Base64::encode(data);
+    std::string url = Base64::encode(data, Variant::Url);
+    std::string decoded;
+
+    if (standard.find_first_of("+/") != std::string::npos) {
+        EXPECT_FALSE(Base64::decode(standard, decoded, Variant::Url));
+    }
+    if (url.find_first_of("-_") != std::string::npos) {
+        EXPECT_FALSE(Base64::decode(url, decoded));
+    }
+}
+
+TEST_P(Base64Test, RejectsBadLengthAndPadding) {
+    std::string decoded;
+
+    EXPECT_FALSE(Base64::decode("Zm9vY", decoded));
+    EXPECT_FALSE(Base64::decode("Zm9v=", decoded));
+    EXPECT_FALSE(Base64::decode("Zg==Zm9v", decoded));
+    EXPECT_FALSE(Base64::decode("Zg==", decoded, Variant::Url));
+    EXPECT_FALSE(Base64::decode("!!!invalid base64!!!", decoded));
+}
+
+INSTANTIATE_TEST_SUITE_P(Kernels, Base64Test,
+                         ::testing::Values(Isa::Scalar, Isa::SSSE3, Isa::AVX2),
+                         [](const ::testing::TestParamInfo<Isa>& info) {
+                             return std::string(Base64::isaName(info.param));
+                         });
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,114 @@
+// tests/unit/test_coarse_clock.cpp
+// Unit tests for the coarse clock and virtual-time expiry checks
+
+#include <gtest/gtest.h>
+#include "coarse_clock.h"
+#include "iso8601.h"
+#include "ticket.h"
+#include "ticket_id.h"
+#include <thread>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+
+namespace {
+
+// Reads the epoch time of a fixed instant
+struct FixedClock {
+    int64_t value;
+    int64_t now() const { return value; }
+};
+
+} // namespace
+
+// ============================================================================
+// COARSE CLOCK
+// ============================================================================
+
+TEST(CoarseClockTest, FallsBackToSystemClockWhenStopped) {
+    CoarseClock::stop();
+    EXPECT_FALSE(CoarseClock::running());
+
+    int64_t before = CoarseClock::systemNowMs();
+    int64_t now = CoarseClock::nowMs();
+    int64_t after = CoarseClock::systemNowMs();
+    EXPECT_GE(now, before);
+    EXPECT_LE(now, after);
+}
+
+TEST(CoarseClockTest, TracksSystemClockWhileRunning) {
+    CoarseClock::start();
+    CoarseClock::start();  // Idempotent
+    EXPECT_TRUE(CoarseClock::running());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // Within a few refresh intervals (generous for loaded CI machines)
+    int64_t drift = CoarseClock::systemNowMs() - CoarseClock::nowMs();
+    EXPECT_GE(drift, 0);
+    EXPECT_LT(drift, 1000);
+    EXPECT_EQ(CoarseClock::now(), CoarseClock::nowMs() / 1000);
+
+    CoarseClock::stop();
+    EXPECT_FALSE(CoarseClock::running());
+}
+
+TEST(CoarseClockTest, FormatsCurrentSecondAsIso8601) {
+    std::string text = CoarseClock::formatNow();
+    ASSERT_EQ(text.size(), Iso8601::kLength);
+
+    int64_t parsed = 0;
+    ASSERT_TRUE(Iso8601::parse(text, parsed));
+    EXPECT_LE(std::abs(parsed - CoarseClock::now()), 1);
+}
+
+// ============================================================================
+// VIRTUAL TIME
+// ============================================================================
+
+TEST(VirtualClockTest, SetAndAdvance) {
+    VirtualClock clock(1704623400);
+    EXPECT_EQ(clock.now(), 1704623400);
+
+    clock.advance(std::chrono::milliseconds(999));
+    EXPECT_EQ(clock.now(), 1704623400);
+    clock.advance(std::chrono::milliseconds(1));
+    EXPECT_EQ(clock.now(), 1704623401);
+    EXPECT_EQ(clock.nowMs(), 1704623401000);
+
+    clock.set(0);
+    EXPECT_EQ(clock.now(), 0);
+}
+
+TEST(VirtualClockTest, TicketExpiresAfterValidityPeriod) {
+    Ticket ticket(TicketIdAllocator::encode(1), 1704623400, 7, 1);
+    VirtualClock clock(1704623400);
+
+    EXPECT_FALSE(ticket.isExpired(clock));
+    EXPECT_TRUE(ticket.isValid(clock));
+
+    clock.advance(std::chrono::hours(24 * 7) - std::chrono::seconds(1));
+    EXPECT_FALSE(ticket.isExpired(clock));
+
+    clock.advance(std::chrono::seconds(1));
+    EXPECT_TRUE(ticket.isExpired(clock));
+    EXPECT_FALSE(ticket.isValid(clock));
+}
+
+TEST(VirtualClockTest, AnyClockWithNow) {
+    Ticket ticket(TicketIdAllocator::encode(1), 1000, 1, 1);
+    EXPECT_FALSE(ticket.isExpired(FixedClock{1000}));
+    EXPECT_TRUE(ticket.isExpired(FixedClock{1000 + Ticket::kSecondsPerDay}));
+
+    Ticket noId("", 1000, 1, 1);
+    EXPECT_FALSE(noId.isValid(FixedClock{1000}));
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,125 @@
+// tests/unit/test_connection_pool.cpp
+// Unit tests for the gate's keep-alive connection pool
+
+#include <gtest/gtest.h>
+#include "connection_pool.h"
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct FakeConnection {
+    int id;
+};
+
+class ConnectionPoolTest : public ::testing::Test {
+protected:
+    using Pool = ConnectionPool<FakeConnection>;
+
+    int nextId = 0;
+
+    Pool makePool(Pool::Config config = Pool::Config()) {
+        return Pool([this] { return std::make_unique<FakeConnection>(FakeConnection{++nextId}); }, config);
+    }
+};
+
+} // namespace
+
+// ============================================================================
+// REUSE
+// ============================================================================
+
+TEST_F(ConnectionPoolTest, ReusesReturnedConnection) {
+    Pool pool = makePool();
+
+    int first = 0;
+    {
+        Pool::Lease lease = pool.acquire();
+        EXPECT_FALSE(lease.reused());
+        first = lease->id;
+    }
+    EXPECT_EQ(pool.idleCount(), 1u);
+
+    Pool::Lease lease = pool.acquire();
+    EXPECT_TRUE(lease.reused());
+    EXPECT_EQ(lease->id, first);
+
+    Pool::Stats stats = pool.stats();
+    EXPECT_EQ(stats.acquired, 2u);
+    EXPECT_EQ(stats.created, 1u);
+    EXPECT_EQ(stats.reused, 1u);
+    EXPECT_DOUBLE_EQ(stats.reuseRate(), 0.5);
+}
+
+TEST_F(ConnectionPoolTest, ConcurrentLeasesGetDistinctConnections) {
+    Pool pool = makePool();
+
+    Pool::Lease a = pool.acquire();
+    Pool::Lease b = pool.acquire();
+    EXPECT_NE(a->id, b->id);
+    EXPECT_EQ(pool.stats().created, 2u);
+}
+
+TEST_F(ConnectionPoolTest, BrokenConnectionIsDiscarded) {
+    Pool pool = makePool();
+    {
+        Pool::Lease lease = pool.acquire();
+        lease.markBroken();
+    }
+    EXPECT_EQ(pool.idleCount(), 0u);
+    EXPECT_EQ(pool.stats().discarded, 1u);
+
+    Pool::Lease lease = pool.acquire();
+    EXPECT_FALSE(lease.reused());
+    EXPECT_EQ(lease->id, 2);
+}
+
+TEST_F(ConnectionPoolTest, KeepsAtMostMaxIdle) {
+    Pool::Config config;
+    config.maxIdle = 2;
+    Pool pool = makePool(config);
+    {
+        std::vector<Pool::Lease> leases;
+        for (int i = 0; i < 4; i++) leases.push_back(pool.acquire());
+    }
+    EXPECT_EQ(pool.idleCount(), 2u);
+    EXPECT_EQ(pool.stats().discarded, 2u);
+}
+
+TEST_F(ConnectionPoolTest, MovedLeaseReturnsOnce) {
+    Pool pool = makePool();
+    {
+        Pool::Lease lease = pool.acquire();
+        Pool::Lease moved = std::move(lease);
+        EXPECT_FALSE(lease);
+        EXPECT_TRUE(moved);
+    }
+    EXPECT_EQ(pool.idleCount(), 1u);
+}
+
+// ============================================================================
+// EXPIRY
+// ============================================================================
+
+TEST_F(ConnectionPoolTest, ExpiredIdleConnectionIsDropped) {
+    Pool::Config config;
+    config.idleTimeout = std::chrono::milliseconds(1);
+    Pool pool = makePool(config);
+    { pool.acquire(); }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    Pool::Lease lease = pool.acquire();
+    EXPECT_FALSE(lease.reused());
+    EXPECT_EQ(pool.stats().discarded, 1u);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,173 @@
+// tests/unit/test_fault_injector.cpp
+// Unit tests for the back-office fault injection settings
+
+#include <gtest/gtest.h>
+#include "fault_injector.h"
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+using Endpoint = FaultInjector::Endpoint;
+using Latency = FaultInjector::Profile::Latency;
+
+namespace {
+
+int countFailures(FaultInjector& faults, Endpoint endpoint, int attempts) {
+    int failures = 0;
+    for (int i = 0; i < attempts; i++) {
+        try {
+            faults.inject(endpoint);
+        } catch (const std::runtime_error&) {
+            failures++;
+        }
+    }
+    return failures;
+}
+
+} // namespace
+
+// ============================================================================
+// SPEC PARSING TESTS
+// ============================================================================
+
+TEST(FaultInjectorTest, EmptySpecIsDisabled) {
+    FaultInjector::Config config = FaultInjector::parseSpec("");
+
+    EXPECT_FALSE(config.enabled);
+    EXPECT_EQ(config.endpoints[0].latency, Latency::None);
+}
+
+TEST(FaultInjectorTest, ParsesLatencyDistributions) {
+    FaultInjector::Config config = FaultInjector::parseSpec(
+        "seed=42;create:latency=100;validate:latency=50-150,error=0.25;report:latency=200~20");
+
+    EXPECT_TRUE(config.enabled);
+    EXPECT_EQ(config.seed, 42u);
+
+    const auto& create = config.endpoints[static_cast<int>(Endpoint::Create)];
+    EXPECT_EQ(create.latency, Latency::Fixed);
+    EXPECT_DOUBLE_EQ(create.latencyMs, 100.0);
+
+    const auto& validate = config.endpoints[static_cast<int>(Endpoint::Validate)];
+    EXPECT_EQ(validate.latency, Latency::Uniform);
+    EXPECT_DOUBLE_EQ(validate.latencyMs, 50.0);
+    EXPECT_DOUBLE_EQ(validate.latencyMaxMs, 150.0);
+    EXPECT_DOUBLE_EQ(validate.errorRate, 0.25);
+
+    const auto& report = config.endpoints[static_cast<int>(Endpoint::Report)];
+    EXPECT_EQ(report.latency, Latency::Normal);
+    EXPECT_DOUBLE_EQ(report.latencyMs, 200.0);
+    EXPECT_DOUBLE_EQ(report.latencyMaxMs, 20.0);
+}
+
+TEST(FaultInjectorTest, RejectsMalformedSpecs) {
+    EXPECT_THROW(FaultInjector::parseSpec("refund:latency=10"), std::invalid_argument);
+    EXPECT_THROW(FaultInjector::parseSpec("create:latency=abc"), std::invalid_argument);
+    EXPECT_THROW(FaultInjector::parseSpec("create:error=1.5"), std::invalid_argument);
+    EXPECT_THROW(FaultInjector::parseSpec("create:latency=200-100"), std::invalid_argument);
+    EXPECT_THROW(FaultInjector::parseSpec("create:latency=200~0"), std::invalid_argument);
+    EXPECT_THROW(FaultInjector::parseSpec("create:jitter=5"), std::invalid_argument);
+    EXPECT_THROW(FaultInjector::parseSpec("latency=100"), std::invalid_argument);
+}
+
+TEST(FaultInjectorTest, JsonRoundTrip) {
+    FaultInjector::Config config = FaultInjector::parseSpec("seed=7;validate:latency=150-250,error=0.1");
+    FaultInjector::Config copy = FaultInjector::fromJson(FaultInjector::toJson(config));
+
+    EXPECT_EQ(copy.enabled, config.enabled);
+    EXPECT_EQ(copy.seed, 7u);
+    const auto& validate = copy.endpoints[static_cast<int>(Endpoint::Validate)];
+    EXPECT_EQ(validate.latency, Latency::Uniform);
+    EXPECT_DOUBLE_EQ(validate.latencyMs, 150.0);
+    EXPECT_DOUBLE_EQ(validate.latencyMaxMs, 250.0);
+    EXPECT_DOUBLE_EQ(validate.errorRate, 0.1);
+}
+
+TEST(FaultInjectorTest, JsonRejectsUnknownDistribution) {
+    json j = {{"endpoints", {{"create", {{"latency", "exponential"}}}}}};
+
+    EXPECT_THROW(FaultInjector::fromJson(j), std::invalid_argument);
+}
+
+TEST(FaultInjectorTest, JsonRejectsNegativeLatency) {
+    for (const char* distribution : {"fixed", "uniform", "normal"}) {
+        json negativeMin = {{"endpoints", {{"create", {{"latency", distribution}, {"latencyMs", -5},
+                                                       {"latencyMaxMs", 10}}}}}};
+        json negativeMax = {{"endpoints", {{"create", {{"latency", distribution}, {"latencyMs", 5},
+                                                       {"latencyMaxMs", -5}}}}}};
+        EXPECT_THROW(FaultInjector::fromJson(negativeMin), std::invalid_argument) << distribution;
+        EXPECT_THROW(FaultInjector::fromJson(negativeMax), std::invalid_argument) << distribution;
+    }
+
+    json noDeviation = {{"endpoints", {{"validate", {{"latency", "normal"}, {"latencyMs", 200}}}}}};
+    EXPECT_THROW(FaultInjector::fromJson(noDeviation), std::invalid_argument);
+}
+
+// ============================================================================
+// INJECTION TESTS
+// ============================================================================
+
+TEST(FaultInjectorTest, DisabledByDefault) {
+    FaultInjector faults;
+
+    EXPECT_FALSE(faults.enabled());
+    EXPECT_EQ(countFailures(faults, Endpoint::Validate, 1000), 0);
+}
+
+TEST(FaultInjectorTest, ErrorRateIsApplied) {
+    FaultInjector faults;
+    faults.configure(FaultInjector::parseSpec("seed=1;validate:error=0.5;create:error=1"));
+
+    int failures = countFailures(faults, Endpoint::Validate, 2000);
+    EXPECT_GT(failures, 800);
+    EXPECT_LT(failures, 1200);
+    EXPECT_EQ(countFailures(faults, Endpoint::Create, 10), 10);
+    EXPECT_EQ(countFailures(faults, Endpoint::Report, 10), 0);
+}
+
+TEST(FaultInjectorTest, SameSeedReplaysSameFailures) {
+    FaultInjector faults;
+    FaultInjector::Config config = FaultInjector::parseSpec("seed=99;validate:error=0.3");
+
+    auto run = [&] {
+        faults.configure(config);
+        std::vector<bool> outcomes;
+        for (int i = 0; i < 100; i++) {
+            outcomes.push_back(countFailures(faults, Endpoint::Validate, 1) == 1);
+        }
+        return outcomes;
+    };
+
+    EXPECT_EQ(run(), run());
+}
+
+TEST(FaultInjectorTest, FixedLatencyDelaysCall) {
+    FaultInjector faults;
+    faults.configure(FaultInjector::parseSpec("create:latency=20"));
+
+    auto started = std::chrono::steady_clock::now();
+    faults.inject(Endpoint::Create);
+    auto elapsed = std::chrono::steady_clock::now() - started;
+
+    EXPECT_GE(elapsed, std::chrono::milliseconds(20));
+}
+
+TEST(FaultInjectorTest, ConfigureCanDisable) {
+    FaultInjector faults;
+    faults.configure(FaultInjector::parseSpec("validate:error=1"));
+    ASSERT_TRUE(faults.enabled());
+
+    faults.configure(FaultInjector::fromJson(json{{"enabled", false}}));
+
+    EXPECT_FALSE(faults.enabled());
+    EXPECT_EQ(countFailures(faults, Endpoint::Validate, 10), 0);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,151 @@
+// tests/unit/test_payload_codec.cpp
+// Unit tests for JSON / CBOR / MessagePack payloads and format negotiation
+
+#include <gtest/gtest.h>
+#include "payload_codec.h"
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+
+using json = nlohmann::json;
+
+namespace {
+
+json sampleRequest() {
+    return {{"ticketBase64", "ATEHACoAAAA5MAAAAAAAACh9mmUAAAAAYCbadmJsybIq8P39"}, {"lineNumber", 42}};
+}
+
+} // namespace
+
+// ============================================================================
+// ENCODING
+// ============================================================================
+
+TEST(PayloadCodecTest, RoundTripEveryFormat) {
+    json value = sampleRequest();
+    for (PayloadFormat format : {PayloadFormat::Json, PayloadFormat::Cbor, PayloadFormat::MessagePack}) {
+        std::string payload = PayloadCodec::dump(value, format);
+        EXPECT_EQ(PayloadCodec::parse(payload, format), value) << PayloadCodec::name(format);
+    }
+}
+
+TEST(PayloadCodecTest, BinaryFormatsAreCompact) {
+    json value = sampleRequest();
+    std::string text = PayloadCodec::dump(value, PayloadFormat::Json);
+    EXPECT_EQ(text, value.dump());
+
+    // {"lineNumber": 42} as a one-entry map: 0xA1 in CBOR, 0x81 in MessagePack
+    std::string cbor = PayloadCodec::dump({{"lineNumber", 42}}, PayloadFormat::Cbor);
+    std::string msgpack = PayloadCodec::dump({{"lineNumber", 42}}, PayloadFormat::MessagePack);
+    EXPECT_EQ(static_cast<unsigned char>(cbor[0]), 0xA1);
+    EXPECT_EQ(static_cast<unsigned char>(msgpack[0]), 0x81);
+    EXPECT_LT(PayloadCodec::dump(value, PayloadFormat::Cbor).size(), text.size());
+    EXPECT_LT(PayloadCodec::dump(value, PayloadFormat::MessagePack).size(), text.size());
+}
+
+TEST(PayloadCodecTest, MalformedPayloadThrows) {
+    EXPECT_THROW(PayloadCodec::parse("{\"a\":", PayloadFormat::Json), json::parse_error);
+    EXPECT_THROW(PayloadCodec::parse("\xA1", PayloadFormat::Cbor), json::parse_error);
+    EXPECT_THROW(PayloadCodec::parse("", PayloadFormat::MessagePack), json::parse_error);
+}
+
+// ============================================================================
+// CONTENT NEGOTIATION
+// ============================================================================
+
+TEST(PayloadCodecTest, ContentTypes) {
+    PayloadFormat format = PayloadFormat::Json;
+    EXPECT_TRUE(PayloadCodec::fromContentType("application/cbor", format));
+    EXPECT_EQ(format, PayloadFormat::Cbor);
+    EXPECT_TRUE(PayloadCodec::fromContentType("Application/X-MsgPack", format));
+    EXPECT_EQ(format, PayloadFormat::MessagePack);
+    EXPECT_TRUE(PayloadCodec::fromContentType("application/json; charset=utf-8", format));
+    EXPECT_EQ(format, PayloadFormat::Json);
+
+    EXPECT_FALSE(PayloadCodec::fromContentType("application/x-www-form-urlencoded", format));
+    EXPECT_FALSE(PayloadCodec::fromContentType("", format));
+    EXPECT_EQ(format, PayloadFormat::Json);
+
+    for (PayloadFormat f : {PayloadFormat::Json, PayloadFormat::Cbor, PayloadFormat::MessagePack}) {
+        ASSERT_TRUE(PayloadCodec::fromContentType(PayloadCodec::contentType(f), format));
+        EXPECT_EQ(format, f);
+    }
+}
+
+TEST(PayloadCodecTest, NegotiateAccept) {
+    EXPECT_EQ(PayloadCodec::negotiate("", PayloadFormat::Cbor), PayloadFormat::Cbor);
+    EXPECT_EQ(PayloadCodec::negotiate("*/*", PayloadFormat::Cbor), PayloadFormat::Cbor);
+    EXPECT_EQ(PayloadCodec::negotiate("text/html", PayloadFormat::Json), PayloadFormat::Json);
+    EXPECT_EQ(PayloadCodec::negotiate("application/msgpack", PayloadFormat::Json), PayloadFormat::MessagePack);
+
+    // Highest q wins, ties go to the first listed
+    EXPECT_EQ(PayloadCodec::negotiate("application/json;q=0.5, application/cbor", PayloadFormat::Json),
+              PayloadFormat::Cbor);
+    EXPECT_EQ(PayloadCodec::negotiate("application/cbor;q=0.9, application/json;q=0.95", PayloadFormat::Cbor),
+              PayloadFormat::Json);
+    EXPECT_EQ(PayloadCodec::negotiate("application/msgpack, application/cbor", PayloadFormat::Json),
+              PayloadFormat::MessagePack);
+    EXPECT_EQ(PayloadCodec::negotiate("application/cbor;q=0, */*;q=0.1", PayloadFormat::Json),
+              PayloadFormat::Json);
+}
+
+TEST(PayloadCodecTest, FormatNames) {
+    PayloadFormat format = PayloadFormat::Json;
+    EXPECT_TRUE(PayloadCodec::fromName("CBOR", format));
+    EXPECT_EQ(format, PayloadFormat::Cbor);
+    EXPECT_TRUE(PayloadCodec::fromName("msgpack", format));
+    EXPECT_EQ(format, PayloadFormat::MessagePack);
+    EXPECT_FALSE(PayloadCodec::fromName("xml", format));
+    EXPECT_STREQ(PayloadCodec::name(PayloadFormat::MessagePack), "msgpack");
+}
+
+// ============================================================================
+// TOPIC FORMATS
+// ============================================================================
+
+TEST(TopicFormatsTest, MostSpecificFilterWins) {
+    TopicFormats formats = TopicFormats::parse(
+        "ticket/validation/#=cbor, ticket/validation/response=json, ticket/sale/request=msgpack");
+
+    EXPECT_EQ(formats.forTopic("ticket/validation/request"), PayloadFormat::Cbor);
+    EXPECT_EQ(formats.forTopic("ticket/validation/request/001"), PayloadFormat::Cbor);
+    EXPECT_EQ(formats.forTopic("ticket/validation"), PayloadFormat::Cbor);
+    EXPECT_EQ(formats.forTopic("ticket/validation/response"), PayloadFormat::Json);
+    EXPECT_EQ(formats.forTopic("ticket/sale/request"), PayloadFormat::MessagePack);
+    EXPECT_EQ(formats.forTopic("ticket/sale/response"), PayloadFormat::Json);
+    EXPECT_EQ(formats.forTopic("ticket/validations"), PayloadFormat::Json);
+}
+
+TEST(TopicFormatsTest, CatchAllAndOverride) {
+    TopicFormats formats = TopicFormats::parse("#=msgpack,ticket/#=cbor");
+    EXPECT_EQ(formats.forTopic("other"), PayloadFormat::MessagePack);
+    EXPECT_EQ(formats.forTopic("ticket/sale/request"), PayloadFormat::Cbor);
+
+    formats.set("ticket/#", PayloadFormat::Json);
+    EXPECT_EQ(formats.forTopic("ticket/sale/request"), PayloadFormat::Json);
+    EXPECT_EQ(formats.describe(), "#=msgpack, ticket/#=json");
+}
+
+TEST(TopicFormatsTest, EmptySpecMeansJson) {
+    TopicFormats formats = TopicFormats::parse("");
+    EXPECT_TRUE(formats.empty());
+    EXPECT_EQ(formats.forTopic("ticket/sale/request"), PayloadFormat::Json);
+    EXPECT_EQ(formats.describe(), "json");
+}
+
+TEST(TopicFormatsTest, InvalidSpecRejected) {
+    EXPECT_THROW(TopicFormats::parse("ticket/sale/request"), std::invalid_argument);
+    EXPECT_THROW(TopicFormats::parse("ticket/sale/request=xml"), std::invalid_argument);
+    EXPECT_THROW(TopicFormats::parse("=cbor"), std::invalid_argument);
+    EXPECT_THROW(TopicFormats::parse("ticket/+/request=cbor"), std::invalid_argument);
+    EXPECT_THROW(TopicFormats::parse("ticket#=cbor"), std::invalid_argument);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,246 @@
+// tests/unit/test_report_shipper.cpp
+// Unit tests for the gate's background report shipper
+
+#include <gtest/gtest.h>
+#include "report_shipper.h"
+#include "mpsc_queue.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+// Records every report it is handed; fails the first `failures` sends
+class Collector {
+public:
+    explicit Collector(int failures = 0) : failures_(failures) {}
+
+    ReportShipper::Build build() {
+        return [](const std::vector<ValidationRecord>& records) {
+            std::string report;
+            for (const auto& record : records) report += std::string(record.ticketId) + ";";
+            return report;
+        };
+    }
+
+    ReportShipper::Send send() {
+        return [this](const std::string& report) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            attempts_.push_back(std::chrono::steady_clock::now());
+            if (failures_ > 0) {
+                failures_--;
+                return false;
+            }
+            reports_.push_back(report);
+            return true;
+        };
+    }
+
+    std::vector<std::string> reports() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return reports_;
+    }
+
+    std::vector<std::chrono::steady_clock::time_point> attempts() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return attempts_;
+    }
+
+    // Polls until `count` reports arrived or the timeout passed
+    bool waitFor(size_t count, std::chrono::milliseconds timeout = 5s) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (std::chrono::steady_clock::now() < deadline) {
+            if (reports().size() >= count) return true;
+            std::this_thread::sleep_for(5ms);
+        }
+        return false;
+    }
+
+private:
+    std::mutex mutex_;
+    int failures_;
+    std::vector<std::string> reports_;
+    std::vector<std::chrono::steady_clock::time_point> attempts_;
+};
+
+ValidationRecord record(const std::string& ticketId) {
+    ValidationRecord record{};
+    record.setTicketId(ticketId);
+    record.valid = true;
+    record.setValidationMode("offline");
+    return record;
+}
+
+ReportShipper::Config config(size_t batchSize, std::chrono::milliseconds flushInterval) {
+    ReportShipper::Config config;
+    config.batchSize = batchSize;
+    config.flushInterval = flushInterval;
+    return config;
+}
+
+} // namespace
+
+// ============================================================================
+// RECORD
+// ============================================================================
+
+TEST(ValidationRecordTest, IsPlainData) {
+    EXPECT_TRUE(std::is_trivially_copyable<ValidationRecord>::value);
+    EXPECT_TRUE(std::is_standard_layout<ValidationRecord>::value);
+}
+
+TEST(ValidationRecordTest, TruncatesLongTicketId) {
+    std::string uuid = "123e4567-e89b-12d3-a456-426614174000";
+    std::string longId(100, 'X');
+
+    EXPECT_STREQ(record(uuid).ticketId, uuid.c_str());
+    EXPECT_EQ(std::strlen(record(longId).ticketId), ValidationRecord::kMaxTicketIdLength);
+}
+
+// ============================================================================
+// FLUSH TRIGGERS
+// ============================================================================
+
+TEST(ReportShipperTest, ShipsWhenBatchIsFull) {
+    Collector collector;
+    ReportShipper shipper(collector.build(), collector.send(), config(3, 1h));
+
+    shipper.add(record("A"));
+    shipper.add(record("B"));
+    std::this_thread::sleep_for(50ms);
+    EXPECT_TRUE(collector.reports().empty());
+
+    shipper.add(record("C"));
+    ASSERT_TRUE(collector.waitFor(1));
+    EXPECT_EQ(collector.reports()[0], "A;B;C;");
+
+    // The counters move once send returns; stop() waits for that
+    shipper.stop();
+    EXPECT_EQ(shipper.stats().shipped, 3u);
+}
+
+TEST(ReportShipperTest, ShipsPartialBatchAfterInterval) {
+    Collector collector;
+    ReportShipper shipper(collector.build(), collector.send(), config(100, 150ms));
+
+    auto start = std::chrono::steady_clock::now();
+    shipper.add(record("A"));
+    ASSERT_TRUE(collector.waitFor(1));
+
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 100ms);
+    EXPECT_EQ(collector.reports()[0], "A;");
+}
+
+TEST(ReportShipperTest, NoReportWithoutRecords) {
+    Collector collector;
+    ReportShipper shipper(collector.build(), collector.send(), config(1, 20ms));
+
+    std::this_thread::sleep_for(100ms);
+    shipper.stop();
+
+    EXPECT_TRUE(collector.attempts().empty());
+    EXPECT_EQ(shipper.stats().reports, 0u);
+}
+
+// ============================================================================
+// RETRIES AND SHUTDOWN
+// ============================================================================
+
+TEST(ReportShipperTest, RetriesWithBackoff) {
+    Collector collector(2);
+    ReportShipper::Config cfg = config(1, 1h);
+    cfg.retryDelay = 40ms;
+    ReportShipper shipper(collector.build(), collector.send(), cfg);
+
+    shipper.add(record("A"));
+    ASSERT_TRUE(collector.waitFor(1));
+    EXPECT_EQ(collector.reports()[0], "A;");
+
+    auto attempts = collector.attempts();
+    ASSERT_EQ(attempts.size(), 3u);
+    EXPECT_GE(attempts[1] - attempts[0], 35ms);
+    EXPECT_GE(attempts[2] - attempts[1], 75ms);  // Doubled
+
+    shipper.stop();
+    ReportShipper::Stats stats = shipper.stats();
+    EXPECT_EQ(stats.failures, 2u);
+    EXPECT_EQ(stats.reports, 1u);
+}
+
+TEST(ReportShipperTest, StopShipsRemainder) {
+    Collector collector;
+    ReportShipper shipper(collector.build(), collector.send(), config(100, 1h));
+
+    shipper.add(record("A"));
+    shipper.add(record("B"));
+    shipper.stop();
+
+    ASSERT_EQ(collector.reports().size(), 1u);
+    EXPECT_EQ(collector.reports()[0], "A;B;");
+}
+
+TEST(ReportShipperTest, DropsOldestBeyondMaxBuffered) {
+    Collector collector(1000);  // Back-Office down
+    ReportShipper::Config cfg = config(2, 1h);
+    cfg.maxBuffered = 4;
+    cfg.retryDelay = 1h;
+    ReportShipper shipper(collector.build(), collector.send(), cfg);
+
+    for (int i = 0; i < 10; i++) {
+        shipper.add(record(std::to_string(i)));
+    }
+    shipper.stop();
+
+    EXPECT_EQ(shipper.stats().dropped, 6u);
+    EXPECT_EQ(shipper.stats().shipped, 0u);
+}
+
+// ============================================================================
+// MPSC QUEUE
+// ============================================================================
+
+TEST(MpscQueueTest, DeliversEveryPushOnce) {
+    MpscQueue<int> queue;
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 10000;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; p++) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kPerProducer; i++) queue.push(p * kPerProducer + i);
+        });
+    }
+
+    std::set<int> seen;
+    std::vector<int> lastPerProducer(kProducers, -1);
+    while (seen.size() < static_cast<size_t>(kProducers * kPerProducer)) {
+        int value;
+        if (!queue.tryPop(value)) continue;
+        EXPECT_TRUE(seen.insert(value).second);
+        // Each producer's values arrive in push order
+        int producer = value / kPerProducer;
+        EXPECT_GT(value, lastPerProducer[producer]);
+        lastPerProducer[producer] = value;
+    }
+    for (auto& producer : producers) producer.join();
+
+    int value;
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
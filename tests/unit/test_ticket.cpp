@@ -3,8 +3,11 @@
 
 #include <gtest/gtest.h>
 #include "ticket.h"
-#include <thread>
-#include <chrono>
+#include "ticket_id.h"
+#include "iso8601.h"
+#include "base64.h"
+#include "ticket_codec.h"
+#include "coarse_clock.h"
 
 /**
  * Test fixture for Ticket class
@@ -56,9 +59,10 @@ TEST_F(TicketTest, ValidTicket) {
 TEST_F(TicketTest, ExpiredTicketZeroDays) {
     Ticket ticket("TKT-003", 0, 1);
     
-    // Wait a moment to ensure expiry
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    
+    // Expires at its own creation time, no need to wait
+    VirtualClock clock(ticket.getCreationTime());
+    EXPECT_TRUE(ticket.isExpired(clock));
+    EXPECT_FALSE(ticket.isValid(clock));
     EXPECT_TRUE(ticket.isExpired());
     EXPECT_FALSE(ticket.isValid());
 }
@@ -189,6 +193,226 @@ TEST_F(TicketTest, InvalidBase64Handling) {
     EXPECT_THROW(Ticket::fromBase64(invalidBase64), std::exception);
 }
 
+// ============================================================================
+// BINARY WIRE FORMAT TESTS
+// ============================================================================
+
+TEST_F(TicketTest, SnowflakeTicketUsesBinaryFormat) {
+    TicketIdAllocator allocator(3);
+    Ticket ticket(allocator.nextString(), 7, 42);
+
+    std::string binary;
+    ASSERT_TRUE(ticket.toBinary(binary));
+    EXPECT_EQ(binary.size(), Ticket::kWireSize);
+    EXPECT_EQ(static_cast<uint8_t>(binary[0]), Ticket::kWireVersion);
+
+    // 24 bytes -> 32 Base64 characters, against well over 100 for JSON
+    EXPECT_EQ(ticket.toBase64().size(), 32u);
+}
+
+TEST_F(TicketTest, BinaryRoundTrip) {
+    TicketIdAllocator allocator(3);
+    Ticket original(allocator.nextString(), "2024-03-15T08:45:12", 365, 123456);
+
+    Ticket decoded = Ticket::fromBase64(original.toBase64());
+
+    EXPECT_EQ(decoded.getId(), original.getId());
+    EXPECT_EQ(decoded.getCreationDate(), "2024-03-15T08:45:12");
+    EXPECT_EQ(decoded.getValidityDays(), 365);
+    EXPECT_EQ(decoded.getLineNumber(), 123456);
+}
+
+TEST_F(TicketTest, LegacyIdsFallBackToJson) {
+    std::string binary;
+
+    EXPECT_FALSE(Ticket("TKT-1-1736335200", 7, 1).toBinary(binary));
+    EXPECT_FALSE(Ticket(TicketIdAllocator::encode(1), 70000, 1).toBinary(binary));
+    // Lower-case IDs decode but must keep their exact spelling
+    EXPECT_FALSE(Ticket("00bxj7q2r0g01", 7, 1).toBinary(binary));
+}
+
+TEST_F(TicketTest, UnknownBinaryVersionRejected) {
+    TicketIdAllocator allocator;
+    std::string binary;
+    ASSERT_TRUE(Ticket(allocator.nextString(), 7, 1).toBinary(binary));
+
+    binary[0] = 2;
+    EXPECT_THROW(Ticket::fromBinary(binary), std::runtime_error);
+    EXPECT_THROW(Ticket::fromBinary(binary.substr(0, 10)), std::runtime_error);
+}
+
+// ============================================================================
+// ALLOCATION-FREE DECODE TESTS
+// ============================================================================
+
+TEST_F(TicketTest, TryFromBase64MatchesJsonParser) {
+    Ticket original("TKT-020", "2024-01-07T10:30:00", 30, 12);
+    std::string base64 = original.toBase64();
+
+    Ticket scanned;
+    ASSERT_TRUE(Ticket::tryFromBase64(base64, scanned));
+    EXPECT_EQ(scanned.getId(), "TKT-020");
+    EXPECT_EQ(scanned.getCreationTime(), original.getCreationTime());
+    EXPECT_EQ(scanned.getValidityDays(), 30);
+    EXPECT_EQ(scanned.getLineNumber(), 12);
+}
+
+TEST_F(TicketTest, TryFromBase64ReadsBinaryFormat) {
+    TicketIdAllocator allocator(5);
+    Ticket original(allocator.nextString(), "2024-03-15T08:45:12", 7, 3);
+
+    Ticket scanned;
+    ASSERT_TRUE(Ticket::tryFromBase64(original.toBase64(), scanned));
+    EXPECT_EQ(scanned.getId(), original.getId());
+    EXPECT_EQ(scanned.getCreationDate(), "2024-03-15T08:45:12");
+    EXPECT_EQ(scanned.getValidityDays(), 7);
+    EXPECT_EQ(scanned.getLineNumber(), 3);
+}
+
+TEST_F(TicketTest, TryFromBase64HandlesJsonVariations) {
+    // Other key order, whitespace, escapes and unknown keys
+    std::string json = "{ \"lineNumber\" : -4, \"extra\": {\"a\": [1, \"}\"]},"
+                       " \"ticketId\": \"T\\\"\\u00e9\\ud83d\\ude80\","
+                       " \"flag\": true, \"validityDays\": 2,"
+                       " \"creationDate\": \"2024-02-29T23:59:59Z\" }";
+    std::string base64 = Base64::encode(json);
+
+    Ticket scanned;
+    ASSERT_TRUE(Ticket::tryFromBase64(base64, scanned));
+    EXPECT_EQ(scanned.getId(), "T\"\xC3\xA9\xF0\x9F\x9A\x80");
+    EXPECT_EQ(scanned.getCreationDate(), "2024-02-29T23:59:59");
+    EXPECT_EQ(scanned.getValidityDays(), 2);
+    EXPECT_EQ(scanned.getLineNumber(), -4);
+}
+
+TEST_F(TicketTest, TryFromBase64RejectsBadPayloads) {
+    const char* payloads[] = {
+        "",
+        "{}",
+        "{\"ticketId\": \"T\", \"creationDate\": \"2024-01-01T00:00:00\", \"validityDays\": 1}",
+        "{\"ticketId\": 5, \"creationDate\": \"2024-01-01T00:00:00\", \"validityDays\": 1, \"lineNumber\": 1}",
+        "{\"ticketId\": \"T\", \"creationDate\": \"2024-13-01T00:00:00\", \"validityDays\": 1, \"lineNumber\": 1}",
+        "{\"ticketId\": \"T\", \"creationDate\": \"2024-01-01T00:00:00\", \"validityDays\": 1.5, \"lineNumber\": 1}",
+        "{\"ticketId\": \"T\", \"creationDate\": \"2024-01-01T00:00:00\", \"validityDays\": 1, \"lineNumber\": 1",
+        "{\"ticketId\": \"T\", \"creationDate\": \"2024-01-01T00:00:00\", \"validityDays\": 1, \"lineNumber\": 1} x",
+    };
+
+    for (const char* payload : payloads) {
+        Ticket scanned;
+        EXPECT_FALSE(Ticket::tryFromBase64(Base64::encode(payload), scanned)) << payload;
+    }
+
+    Ticket scanned;
+    EXPECT_FALSE(Ticket::tryFromBase64("!!!invalid base64!!!", scanned));
+    EXPECT_FALSE(Ticket::tryFromBase64(std::string(1024, 'A'), scanned));
+}
+
+TEST_F(TicketTest, TryFromBase64ReusesTicket) {
+    Ticket first("TKT-A", 1, 1);
+    Ticket second("TKT-B", 2, 2);
+
+    Ticket scanned;
+    ASSERT_TRUE(Ticket::tryFromBase64(first.toBase64(), scanned));
+    ASSERT_TRUE(Ticket::tryFromBase64(second.toBase64(), scanned));
+    EXPECT_EQ(scanned.getId(), "TKT-B");
+    EXPECT_EQ(scanned.getValidityDays(), 2);
+}
+
+TEST_F(TicketTest, RecordConversion) {
+    TicketIdAllocator allocator(1);
+    Ticket snowflake(allocator.nextString(), "2024-03-15T08:45:12", 30, 7);
+
+    TicketRecord record = snowflake.toRecord();
+    EXPECT_FALSE(record.hasLegacyId());
+    EXPECT_EQ(record.validityDays, 30);
+    EXPECT_EQ(record.lineNumber, 7);
+    EXPECT_EQ(record.expiryTime(), snowflake.getExpiryTime());
+
+    Ticket restored = Ticket::fromRecord(record);
+    EXPECT_EQ(restored.getId(), snowflake.getId());
+    EXPECT_EQ(restored.getCreationDate(), "2024-03-15T08:45:12");
+
+    // Legacy IDs pack as a flag only; the text travels separately
+    TicketRecord legacy = Ticket("TKT-1-1736335200", 7, 1).toRecord();
+    EXPECT_TRUE(legacy.hasLegacyId());
+    EXPECT_EQ(Ticket::fromRecord(legacy, "TKT-1-1736335200").getId(), "TKT-1-1736335200");
+    EXPECT_TRUE(Ticket("00bxj7q2r0g01", 7, 1).toRecord().hasLegacyId());
+}
+
+// ============================================================================
+// BULK CODEC TESTS
+// ============================================================================
+
+TEST_F(TicketTest, EncodeManyMatchesToBase64) {
+    TicketIdAllocator allocator(1);
+    std::vector<Ticket> tickets = {
+        Ticket(allocator.nextString(), 7, 1),
+        Ticket("TKT-1-1736335200", 30, 2),
+        Ticket("TKT-\"quoted\"\\\n\x01-\xC3\xA9", 1, 3),
+        Ticket(allocator.nextString(), 365, 4),
+    };
+
+    std::string encoded = "prefix";
+    std::vector<size_t> ends;
+    TicketCodec::encodeMany(tickets, encoded, ends);
+
+    ASSERT_EQ(ends.size(), tickets.size());
+    size_t begin = 6;
+    for (size_t i = 0; i < tickets.size(); i++) {
+        EXPECT_EQ(encoded.substr(begin, ends[i] - begin), tickets[i].toBase64());
+        begin = ends[i];
+    }
+    EXPECT_EQ(begin, encoded.size());
+}
+
+TEST_F(TicketTest, JsonPayloadMatchesToJson) {
+    // Legacy tickets are written without a DOM; the bytes must not change
+    Ticket ticket("TKT-\"quoted\"\\\n\t\x1f-\xC3\xA9", "2024-01-07T10:30:00", 30, -2);
+
+    std::string payload;
+    ASSERT_TRUE(Base64::decode(ticket.toBase64(), payload));
+    EXPECT_EQ(payload, ticket.toJson());
+}
+
+TEST_F(TicketTest, DecodeManyReportsPerItemStatus) {
+    TicketIdAllocator allocator(1);
+    Ticket binary(allocator.nextString(), 7, 1);
+    Ticket legacy("TKT-9", 30, 2);
+
+    std::vector<std::string> texts = {
+        binary.toBase64(),
+        "!!!not base64!!!",
+        Base64::encode("{\"ticketId\": \"T\"}"),
+        legacy.toBase64(),
+        std::string(2048, 'A'),
+    };
+
+    std::vector<Ticket> tickets;
+    std::vector<TicketCodec::Status> statuses;
+    EXPECT_EQ(TicketCodec::decodeMany(texts, tickets, statuses), 2u);
+
+    ASSERT_EQ(statuses.size(), 5u);
+    EXPECT_EQ(statuses[0], TicketCodec::Status::Ok);
+    EXPECT_EQ(statuses[1], TicketCodec::Status::InvalidBase64);
+    EXPECT_EQ(statuses[2], TicketCodec::Status::InvalidPayload);
+    EXPECT_EQ(statuses[3], TicketCodec::Status::Ok);
+    EXPECT_EQ(statuses[4], TicketCodec::Status::TooLong);
+    EXPECT_EQ(tickets[0].getId(), binary.getId());
+    EXPECT_EQ(tickets[3].getId(), "TKT-9");
+    EXPECT_EQ(tickets[3].getValidityDays(), 30);
+}
+
+TEST_F(TicketTest, DecodeManyOverStringViews) {
+    std::string first = Ticket("TKT-A", 1, 1).toBase64();
+    std::string second = Ticket("TKT-B", 2, 2).toBase64();
+    std::string_view texts[] = {first, second};
+
+    Ticket tickets[2];
+    TicketCodec::Status statuses[2];
+    EXPECT_EQ(TicketCodec::decodeMany(texts, 2, tickets, statuses), 2u);
+    EXPECT_EQ(tickets[1].getId(), "TKT-B");
+}
+
 // ============================================================================
 // DATE PARSING AND EXPIRY TESTS
 // ============================================================================
@@ -207,6 +431,53 @@ TEST_F(TicketTest, CreationDateFormat) {
     EXPECT_EQ(date[16], ':');
 }
 
+TEST_F(TicketTest, CreationDateIsUtcEpoch) {
+    Ticket ticket("TKT-013", "2024-01-07T10:30:00", 7, 1);
+
+    EXPECT_EQ(ticket.getCreationTime(), 1704623400);
+    EXPECT_EQ(ticket.getExpiryTime(), 1704623400 + 7 * 86400);
+    EXPECT_EQ(ticket.getCreationDate(), "2024-01-07T10:30:00");
+}
+
+TEST_F(TicketTest, InvalidCreationDateRejected) {
+    EXPECT_THROW(Ticket("TKT-013", "not-a-date", 7, 1), std::invalid_argument);
+    EXPECT_THROW(Ticket("TKT-013", "2023-02-29T00:00:00", 7, 1), std::invalid_argument);
+    EXPECT_THROW(Ticket::fromJson(R"({"ticketId": "TKT-1", "creationDate": "2024-01-07", )"
+                                  R"("validityDays": 1, "lineNumber": 1})"),
+                 std::invalid_argument);
+}
+
+TEST_F(TicketTest, ExpiresExactlyAfterValidityPeriod) {
+    Ticket ticket("TKT-013", "2024-01-07T10:30:00", 1, 1);
+    int64_t created = ticket.getCreationTime();
+
+    EXPECT_FALSE(ticket.isExpiredAt(created));
+    EXPECT_FALSE(ticket.isExpiredAt(created + 86399));
+    EXPECT_TRUE(ticket.isExpiredAt(created + 86400));
+}
+
+TEST_F(TicketTest, Iso8601RoundTrip) {
+    int64_t epoch = 0;
+
+    ASSERT_TRUE(Iso8601::parse("1970-01-01T00:00:00", epoch));
+    EXPECT_EQ(epoch, 0);
+    ASSERT_TRUE(Iso8601::parse("2024-02-29T23:59:59Z", epoch));
+    EXPECT_EQ(Iso8601::format(epoch), "2024-02-29T23:59:59");
+    EXPECT_EQ(Iso8601::format(-1), "1969-12-31T23:59:59");
+
+    // Every day over a few centuries, including leap years
+    for (int64_t days = -100000; days < 100000; days += 7) {
+        std::string text = Iso8601::format(days * 86400 + 12345);
+        ASSERT_TRUE(Iso8601::parse(text, epoch)) << text;
+        ASSERT_EQ(epoch, days * 86400 + 12345) << text;
+    }
+
+    EXPECT_FALSE(Iso8601::parse("2024-01-07 10:30:00", epoch));
+    EXPECT_FALSE(Iso8601::parse("2024-01-07T24:00:00", epoch));
+    EXPECT_FALSE(Iso8601::parse("2024-1-07T10:30:00", epoch));
+    EXPECT_FALSE(Iso8601::parse("", epoch));
+}
+
 TEST_F(TicketTest, ExpiryCalculation) {
     Ticket ticket("TKT-014", 1, 1);
     
@@ -0,0 +1,179 @@
+// tests/unit/test_ticket_id.cpp
+// Unit tests for the Snowflake-style ticket ID allocator
+
+#include <gtest/gtest.h>
+#include "ticket_id.h"
+#include <algorithm>
+#include <set>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+
+namespace {
+
+int64_t fakeNow = TicketIdAllocator::kEpochMs + 1000;
+
+int64_t fakeClock() {
+    return fakeNow;
+}
+
+} // namespace
+
+// ============================================================================
+// ALLOCATION TESTS
+// ============================================================================
+
+TEST(TicketIdTest, IdsCarryTimestampNodeAndSequence) {
+    fakeNow = TicketIdAllocator::kEpochMs + 1000;
+    TicketIdAllocator allocator(5, fakeClock);
+
+    uint64_t first = allocator.next();
+    uint64_t second = allocator.next();
+
+    EXPECT_EQ(TicketIdAllocator::timestampMs(first), fakeNow);
+    EXPECT_EQ(TicketIdAllocator::nodeOf(first), 5u);
+    EXPECT_EQ(TicketIdAllocator::sequenceOf(first), 0u);
+    EXPECT_EQ(TicketIdAllocator::sequenceOf(second), 1u);
+}
+
+TEST(TicketIdTest, SequenceResetsOnNewMillisecond) {
+    fakeNow = TicketIdAllocator::kEpochMs + 1000;
+    TicketIdAllocator allocator(1, fakeClock);
+    allocator.next();
+    allocator.next();
+
+    fakeNow += 1;
+    uint64_t id = allocator.next();
+
+    EXPECT_EQ(TicketIdAllocator::timestampMs(id), fakeNow);
+    EXPECT_EQ(TicketIdAllocator::sequenceOf(id), 0u);
+}
+
+TEST(TicketIdTest, SequenceOverflowBorrowsNextMillisecond) {
+    fakeNow = TicketIdAllocator::kEpochMs + 1000;
+    TicketIdAllocator allocator(0, fakeClock);
+
+    uint64_t previous = 0;
+    for (int i = 0; i < 5000; i++) {
+        uint64_t id = allocator.next();
+        ASSERT_GT(id, previous);
+        previous = id;
+    }
+    EXPECT_EQ(TicketIdAllocator::timestampMs(previous), fakeNow + 1);
+}
+
+TEST(TicketIdTest, ClockGoingBackwardsStaysMonotonic) {
+    fakeNow = TicketIdAllocator::kEpochMs + 5000;
+    TicketIdAllocator allocator(0, fakeClock);
+    uint64_t before = allocator.next();
+
+    fakeNow -= 2000;
+    EXPECT_GT(allocator.next(), before);
+}
+
+TEST(TicketIdTest, BlockIsConsecutiveAndUnique) {
+    fakeNow = TicketIdAllocator::kEpochMs + 1000;
+    TicketIdAllocator allocator(3, fakeClock);
+
+    std::vector<uint64_t> block = allocator.allocateBlock(6000);
+    ASSERT_EQ(block.size(), 6000u);
+    EXPECT_TRUE(std::is_sorted(block.begin(), block.end()));
+    EXPECT_EQ(std::set<uint64_t>(block.begin(), block.end()).size(), block.size());
+    EXPECT_GT(allocator.next(), block.back());
+    EXPECT_TRUE(allocator.allocateBlock(0).empty());
+}
+
+TEST(TicketIdTest, ConcurrentAllocationIsUnique) {
+    TicketIdAllocator allocator(7);
+    std::vector<std::vector<uint64_t>> perThread(8);
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < perThread.size(); t++) {
+        threads.emplace_back([&allocator, &perThread, t] {
+            for (int i = 0; i < 10000; i++) {
+                perThread[t].push_back(allocator.next());
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    std::set<uint64_t> all;
+    for (const auto& ids : perThread) {
+        EXPECT_TRUE(std::is_sorted(ids.begin(), ids.end()));
+        all.insert(ids.begin(), ids.end());
+    }
+    EXPECT_EQ(all.size(), 80000u);
+}
+
+TEST(TicketIdTest, NodesNeverCollide) {
+    fakeNow = TicketIdAllocator::kEpochMs + 1000;
+    TicketIdAllocator a(1, fakeClock);
+    TicketIdAllocator b(2, fakeClock);
+
+    EXPECT_NE(a.next(), b.next());
+}
+
+TEST(TicketIdTest, InvalidNodeThrows) {
+    EXPECT_THROW(TicketIdAllocator(TicketIdAllocator::kMaxNodeId + 1), std::invalid_argument);
+}
+
+TEST(TicketIdTest, NodeIdFromEnvironment) {
+    setenv("BACKOFFICE_NODE_ID", "42", 1);
+    EXPECT_EQ(TicketIdAllocator::nodeIdFromEnvironment(), 42u);
+
+    setenv("BACKOFFICE_NODE_ID", "4096", 1);
+    EXPECT_THROW(TicketIdAllocator::nodeIdFromEnvironment(), std::invalid_argument);
+
+    unsetenv("BACKOFFICE_NODE_ID");
+    EXPECT_EQ(TicketIdAllocator::nodeIdFromEnvironment(), 0u);
+}
+
+// ============================================================================
+// ENCODING TESTS
+// ============================================================================
+
+TEST(TicketIdTest, EncodeDecodeRoundTrip) {
+    for (uint64_t id : {uint64_t{0}, uint64_t{1}, uint64_t{0x0123456789ABCDEF}, UINT64_MAX}) {
+        std::string text = TicketIdAllocator::encode(id);
+        ASSERT_EQ(text.size(), TicketIdAllocator::kEncodedLength);
+
+        uint64_t decoded = 0;
+        ASSERT_TRUE(TicketIdAllocator::decode(text, decoded));
+        EXPECT_EQ(decoded, id);
+    }
+    EXPECT_EQ(TicketIdAllocator::encode(0), "0000000000000");
+    EXPECT_EQ(TicketIdAllocator::encode(UINT64_MAX), "FZZZZZZZZZZZZ");
+}
+
+TEST(TicketIdTest, EncodingPreservesOrder) {
+    TicketIdAllocator allocator;
+    std::string first = allocator.nextString();
+    std::string second = allocator.nextString();
+
+    EXPECT_LT(first, second);
+}
+
+TEST(TicketIdTest, DecodeAcceptsCrockfordAliases) {
+    uint64_t id = 0;
+    ASSERT_TRUE(TicketIdAllocator::decode("000000000000o", id));
+    EXPECT_EQ(id, 0u);
+    ASSERT_TRUE(TicketIdAllocator::decode("000000000000l", id));
+    EXPECT_EQ(id, 1u);
+}
+
+TEST(TicketIdTest, DecodeRejectsInvalidInput) {
+    uint64_t id = 0;
+    EXPECT_FALSE(TicketIdAllocator::decode("", id));
+    EXPECT_FALSE(TicketIdAllocator::decode("TKT-1-1736335200", id));
+    EXPECT_FALSE(TicketIdAllocator::decode("000000000000U", id));
+    EXPECT_FALSE(TicketIdAllocator::decode("G000000000000", id));
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
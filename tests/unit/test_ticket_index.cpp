@@ -0,0 +1,88 @@
+// tests/unit/test_ticket_index.cpp
+// Unit tests for the ticket ID hash index
+
+#include <gtest/gtest.h>
+#include "ticket_index.h"
+#include <string>
+#include <vector>
+
+/**
+ * Test fixture: the index points into a plain vector of IDs, used the way
+ * TicketStore uses it (check with findMatching, then insertUnique)
+ */
+class TicketIndexTest : public ::testing::Test {
+protected:
+    std::vector<std::string> ids_;
+    TicketIndex index_;
+
+    uint32_t find(const std::string& id) const {
+        return index_.findMatching(TicketIndex::hash(id), [&](uint32_t position) { return ids_[position] == id; });
+    }
+
+    bool add(const std::string& id) {
+        if (find(id) != TicketIndex::kNotFound) return false;
+        index_.insertUnique(TicketIndex::hash(id), static_cast<uint32_t>(ids_.size()));
+        ids_.push_back(id);
+        return true;
+    }
+};
+
+// ============================================================================
+// LOOKUP TESTS
+// ============================================================================
+
+TEST_F(TicketIndexTest, EmptyIndexFindsNothing) {
+    EXPECT_EQ(find("TKT-1"), TicketIndex::kNotFound);
+    EXPECT_EQ(index_.size(), 0u);
+}
+
+TEST_F(TicketIndexTest, FindReturnsPosition) {
+    ASSERT_TRUE(add("TKT-1"));
+    ASSERT_TRUE(add("TKT-2"));
+
+    EXPECT_EQ(find("TKT-1"), 0u);
+    EXPECT_EQ(find("TKT-2"), 1u);
+    EXPECT_EQ(find("TKT-3"), TicketIndex::kNotFound);
+}
+
+TEST_F(TicketIndexTest, DuplicateIdRejected) {
+    ASSERT_TRUE(add("TKT-1"));
+
+    EXPECT_FALSE(add("TKT-1"));
+    EXPECT_EQ(index_.size(), 1u);
+}
+
+TEST_F(TicketIndexTest, GrowsPastInitialCapacity) {
+    for (int i = 0; i < 10000; i++) {
+        ASSERT_TRUE(add("TKT-" + std::to_string(i)));
+    }
+
+    EXPECT_EQ(index_.size(), 10000u);
+    EXPECT_GE(index_.capacity() * 7, index_.size() * 10);
+    for (int i = 0; i < 10000; i++) {
+        EXPECT_EQ(find("TKT-" + std::to_string(i)), static_cast<uint32_t>(i));
+    }
+    EXPECT_EQ(find("TKT-10000"), TicketIndex::kNotFound);
+}
+
+TEST_F(TicketIndexTest, ReserveKeepsEntries) {
+    ASSERT_TRUE(add("TKT-1"));
+    index_.reserve(100000);
+
+    EXPECT_GE(index_.capacity(), 100000u);
+    EXPECT_EQ(find("TKT-1"), 0u);
+}
+
+TEST_F(TicketIndexTest, HashIsStable) {
+    EXPECT_EQ(TicketIndex::hash("TKT-1"), TicketIndex::hash(std::string("TKT-1")));
+    EXPECT_NE(TicketIndex::hash("TKT-1"), TicketIndex::hash("TKT-2"));
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,261 @@
+// tests/unit/test_ticket_journal.cpp
+// Unit tests for the append-only ticket journal
+
+#include <gtest/gtest.h>
+#include "ticket_journal.h"
+#include "ticket_csv.h"
+#include "ticket_store.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+/**
+ * Test fixture: every test gets its own temporary stock file
+ */
+class TicketJournalTest : public ::testing::Test {
+protected:
+    std::string dir_;
+    std::string snapshot_;
+    int snapshotWrites_ = 0;
+
+    void SetUp() override {
+        char tmpl[] = "/tmp/ticket_journal_XXXXXX";
+        dir_ = mkdtemp(tmpl);
+        snapshot_ = dir_ + "/tickets.csv";
+    }
+
+    void TearDown() override {
+        for (const char* suffix : {"", ".journal", ".journal.old", ".tmp"}) {
+            std::remove((snapshot_ + suffix).c_str());
+        }
+        rmdir(dir_.c_str());
+    }
+
+    TicketJournal::SnapshotWriter writer(const std::string& content) {
+        return [this, content](const std::string& path) {
+            std::ofstream(path) << content;
+            snapshotWrites_++;
+        };
+    }
+
+    static std::string readFile(const std::string& path) {
+        std::ifstream file(path);
+        std::stringstream ss;
+        ss << file.rdbuf();
+        return ss.str();
+    }
+
+    static bool exists(const std::string& path) {
+        return access(path.c_str(), F_OK) == 0;
+    }
+};
+
+// ============================================================================
+// APPEND TESTS
+// ============================================================================
+
+TEST_F(TicketJournalTest, AppendWritesRows) {
+    TicketJournal journal(snapshot_, writer(""));
+    journal.open();
+    journal.append("TKT-1,2024-01-07T10:30:00,7,1");
+    journal.append(std::vector<std::string>{"TKT-2,2024-01-07T10:31:00,1,2",
+                                            "TKT-3,2024-01-07T10:32:00,30,3"});
+    journal.close();
+
+    EXPECT_EQ(readFile(journal.journalPath()),
+              "TKT-1,2024-01-07T10:30:00,7,1\n"
+              "TKT-2,2024-01-07T10:31:00,1,2\n"
+              "TKT-3,2024-01-07T10:32:00,30,3\n");
+    EXPECT_EQ(journal.replayPaths(), std::vector<std::string>{journal.journalPath()});
+    EXPECT_EQ(journal.stats().records, 3u);
+}
+
+TEST_F(TicketJournalTest, AppendBeforeOpenThrows) {
+    TicketJournal journal(snapshot_, writer(""));
+
+    EXPECT_THROW(journal.append("TKT-1,2024-01-07T10:30:00,7,1"), std::runtime_error);
+}
+
+TEST_F(TicketJournalTest, ConcurrentAppendsAreGroupCommitted) {
+    TicketJournal journal(snapshot_, writer(""));
+    journal.open();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&journal, t] {
+            for (int i = 0; i < 50; i++) {
+                journal.append("TKT-" + std::to_string(t) + "-" + std::to_string(i) +
+                               ",2024-01-07T10:30:00,7,1");
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    TicketJournal::Stats stats = journal.stats();
+    EXPECT_EQ(stats.records, 400u);
+    EXPECT_LE(stats.flushes, stats.records);
+
+    journal.close();
+    std::istringstream rows(readFile(journal.journalPath()));
+    std::string row;
+    int count = 0;
+    while (std::getline(rows, row)) count++;
+    EXPECT_EQ(count, 400);
+}
+
+TEST_F(TicketJournalTest, TornRowIsTerminatedOnOpen) {
+    std::ofstream(snapshot_ + ".journal") << "TKT-1,2024-01-07T10:30:00,7,1\nTKT-2,2024-01";
+
+    TicketJournal journal(snapshot_, writer(""));
+    journal.open();
+    journal.append("TKT-3,2024-01-07T10:32:00,7,1");
+    journal.close();
+
+    EXPECT_EQ(readFile(journal.journalPath()),
+              "TKT-1,2024-01-07T10:30:00,7,1\nTKT-2,2024-01\n"
+              "TKT-3,2024-01-07T10:32:00,7,1\n");
+}
+
+TEST_F(TicketJournalTest, ApplyRunsOnceRowIsDurable) {
+    TicketJournal journal(snapshot_, writer(""));
+    journal.open();
+
+    std::string journaled;
+    journal.append({"TKT-1,2024-01-07T10:30:00,7,1"}, [&] { journaled = readFile(journal.journalPath()); });
+    journal.close();
+
+    EXPECT_EQ(journaled, "TKT-1,2024-01-07T10:30:00,7,1\n");
+}
+
+TEST_F(TicketJournalTest, UnwritableJournalSkipsApply) {
+    // Every write to the journal fails with ENOSPC
+    ASSERT_EQ(symlink("/dev/full", (snapshot_ + ".journal").c_str()), 0);
+
+    TicketStore store;
+    Ticket ticket("TKT-1", "2024-01-07T10:30:00", 7, 1);
+    TicketJournal journal(snapshot_, writer(""));
+    journal.open();
+
+    EXPECT_THROW(journal.append({TicketCsv::formatRow(ticket)}, [&] { store.insert(ticket); }),
+                 std::runtime_error);
+    EXPECT_FALSE(store.contains("TKT-1"));
+
+    // Unavailable from then on; still nothing reaches the store
+    EXPECT_THROW(journal.append({TicketCsv::formatRow(ticket)}, [&] { store.insert(ticket); }),
+                 std::runtime_error);
+    EXPECT_EQ(store.size(), 0u);
+    journal.close();
+}
+
+TEST_F(TicketJournalTest, ApplyBeforeOpenNotCalled) {
+    TicketJournal journal(snapshot_, writer(""));
+    bool applied = false;
+
+    EXPECT_THROW(journal.append({"TKT-1,2024-01-07T10:30:00,7,1"}, [&] { applied = true; }), std::runtime_error);
+    EXPECT_FALSE(applied);
+}
+
+// ============================================================================
+// COMPACTION TESTS
+// ============================================================================
+
+TEST_F(TicketJournalTest, CompactRollsJournalIntoSnapshot) {
+    TicketJournal journal(snapshot_, writer("SNAPSHOT\n"));
+    journal.open();
+    journal.append("TKT-1,2024-01-07T10:30:00,7,1");
+
+    journal.compact();
+    journal.append("TKT-2,2024-01-07T10:31:00,7,1");
+    journal.close();
+
+    EXPECT_EQ(readFile(snapshot_), "SNAPSHOT\n");
+    EXPECT_EQ(readFile(journal.journalPath()), "TKT-2,2024-01-07T10:31:00,7,1\n");
+    EXPECT_FALSE(exists(snapshot_ + ".journal.old"));
+    EXPECT_FALSE(exists(snapshot_ + ".tmp"));
+    EXPECT_EQ(journal.stats().compactions, 1u);
+}
+
+TEST_F(TicketJournalTest, CompactionWaitsForApplyOfRotatedRows) {
+    std::atomic<bool> applied{false};
+    std::atomic<bool> appliedAtSnapshot{false};
+    TicketJournal journal(snapshot_, [&](const std::string& path) {
+        appliedAtSnapshot = applied.load();
+        std::ofstream(path) << "SNAPSHOT\n";
+    });
+    journal.open();
+
+    std::promise<void> durable;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    auto sale = std::async(std::launch::async, [&] {
+        journal.append({"TKT-1,2024-01-07T10:30:00,7,1"}, [&] {
+            durable.set_value();
+            released.wait();
+            applied = true;
+        });
+    });
+    durable.get_future().wait();
+
+    // The row is durable but not applied yet: the snapshot has to wait
+    auto compaction = std::async(std::launch::async, [&] { journal.compact(); });
+    EXPECT_EQ(compaction.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+
+    release.set_value();
+    sale.get();
+    compaction.get();
+    journal.close();
+
+    EXPECT_TRUE(appliedAtSnapshot.load());
+    EXPECT_EQ(journal.stats().compactions, 1u);
+}
+
+TEST_F(TicketJournalTest, BackgroundCompactionAtThreshold) {
+    TicketJournal journal(snapshot_, writer("SNAPSHOT\n"), 10);
+    journal.open();
+    for (int i = 0; i < 10; i++) {
+        journal.append("TKT-" + std::to_string(i) + ",2024-01-07T10:30:00,7,1");
+    }
+
+    for (int i = 0; i < 200 && journal.stats().compactions == 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    journal.close();
+
+    EXPECT_EQ(journal.stats().compactions, 1u);
+    EXPECT_EQ(readFile(snapshot_), "SNAPSHOT\n");
+}
+
+TEST_F(TicketJournalTest, OpenFinishesInterruptedCompaction) {
+    std::ofstream(snapshot_ + ".journal.old") << "TKT-1,2024-01-07T10:30:00,7,1\n";
+
+    TicketJournal journal(snapshot_, writer("SNAPSHOT\n"));
+    ASSERT_EQ(journal.replayPaths().size(), 1u);
+    journal.open();
+    journal.close();
+
+    EXPECT_EQ(snapshotWrites_, 1);
+    EXPECT_EQ(readFile(snapshot_), "SNAPSHOT\n");
+    EXPECT_FALSE(exists(snapshot_ + ".journal.old"));
+}
+
+TEST_F(TicketJournalTest, FormatRowMatchesCsvLayout) {
+    Ticket ticket("TKT-42", "2024-01-07T10:30:00", 7, 3);
+
+    EXPECT_EQ(TicketCsv::formatRow(ticket), "TKT-42,2024-01-07T10:30:00,7,3");
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
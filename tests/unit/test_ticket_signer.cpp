@@ -0,0 +1,166 @@
+// tests/unit/test_ticket_signer.cpp
+// Unit tests for HMAC ticket signatures
+
+#include <gtest/gtest.h>
+#include "ticket_signer.h"
+#include "ticket_id.h"
+#include "base64.h"
+#include "ticket_codec.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// 32-byte keys as hex: 000102...1f and 202122...3f
+const char* const kKey3 = "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f";
+const char* const kKey4 = "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f";
+
+Ticket sampleTicket() {
+    return Ticket(TicketIdAllocator::encode(12345), 1704623400, 7, 42);
+}
+
+} // namespace
+
+// ============================================================================
+// SIGNING AND VERIFICATION
+// ============================================================================
+
+TEST(TicketSignerTest, SignedTicketMatchesReferenceHmac) {
+    TicketSigner signer = TicketSigner::parse(std::string("3:") + kKey3);
+
+    std::string base64;
+    ASSERT_TRUE(signer.sign(sampleTicket(), base64));
+
+    // HMAC-SHA256 truncated to 12 bytes, computed independently
+    EXPECT_EQ(base64, "ATEHACoAAAA5MAAAAAAAACh9mmUAAAAAYCbadmJsybIq8P39");
+}
+
+TEST(TicketSignerTest, SignedTicketVerifies) {
+    TicketSigner signer = TicketSigner::parse(std::string("3:") + kKey3);
+    std::string base64;
+    ASSERT_TRUE(signer.sign(sampleTicket(), base64));
+
+    Ticket ticket;
+    EXPECT_EQ(signer.verify(base64, ticket), TicketSigner::Status::Valid);
+    EXPECT_EQ(ticket.getId(), sampleTicket().getId());
+    EXPECT_EQ(ticket.getCreationTime(), 1704623400);
+    EXPECT_EQ(ticket.getValidityDays(), 7);
+    EXPECT_EQ(ticket.getLineNumber(), 42);
+
+    // Plain decoders still read signed tickets (without checking them)
+    Ticket decoded = Ticket::fromBase64(base64);
+    EXPECT_EQ(decoded.getId(), sampleTicket().getId());
+}
+
+TEST(TicketSignerTest, AlteredTicketRejected) {
+    TicketSigner signer = TicketSigner::parse(std::string("3:") + kKey3);
+    std::string base64;
+    ASSERT_TRUE(signer.sign(sampleTicket(), base64));
+
+    std::string payload;
+    ASSERT_TRUE(Base64::decode(base64, payload));
+
+    // Extend the validity, then flip one MAC bit
+    std::string altered = payload;
+    altered[2] = 30;
+    Ticket ticket;
+    EXPECT_EQ(signer.verify(Base64::encode(altered), ticket), TicketSigner::Status::BadSignature);
+
+    altered = payload;
+    altered.back() ^= 1;
+    EXPECT_EQ(signer.verify(Base64::encode(altered), ticket), TicketSigner::Status::BadSignature);
+}
+
+TEST(TicketSignerTest, KeyRotation) {
+    TicketSigner oldSigner = TicketSigner::parse(std::string("3:") + kKey3);
+    TicketSigner newSigner = TicketSigner::parse(std::string("3:") + kKey3 + ",4:" + kKey4);
+    EXPECT_EQ(newSigner.activeKey(), 4);
+
+    std::string signedOld;
+    std::string signedNew;
+    ASSERT_TRUE(oldSigner.sign(sampleTicket(), signedOld));
+    ASSERT_TRUE(newSigner.sign(sampleTicket(), signedNew));
+    EXPECT_NE(signedOld, signedNew);
+
+    Ticket ticket;
+    EXPECT_EQ(newSigner.verify(signedOld, ticket), TicketSigner::Status::Valid);
+    EXPECT_EQ(newSigner.verify(signedNew, ticket), TicketSigner::Status::Valid);
+    EXPECT_EQ(oldSigner.verify(signedNew, ticket), TicketSigner::Status::UnknownKey);
+
+    // Same key ID, different secret
+    TicketSigner other = TicketSigner::parse(std::string("4:") + kKey3);
+    EXPECT_EQ(other.verify(signedNew, ticket), TicketSigner::Status::BadSignature);
+}
+
+TEST(TicketSignerTest, UnsignedAndMalformedTickets) {
+    TicketSigner signer = TicketSigner::parse(std::string("3:") + kKey3);
+    Ticket ticket;
+
+    EXPECT_EQ(signer.verify(sampleTicket().toBase64(), ticket), TicketSigner::Status::Unsigned);
+    EXPECT_EQ(ticket.getLineNumber(), 42);
+
+    Ticket legacy("TKT-1-1736335200", 7, 1);
+    EXPECT_EQ(signer.verify(legacy.toBase64(), ticket), TicketSigner::Status::Unsigned);
+    EXPECT_EQ(ticket.getId(), "TKT-1-1736335200");
+
+    EXPECT_EQ(signer.verify("!!!", ticket), TicketSigner::Status::Malformed);
+    EXPECT_EQ(signer.verify("", ticket), TicketSigner::Status::Malformed);
+    EXPECT_EQ(signer.verify(Base64::encode("short"), ticket), TicketSigner::Status::Malformed);
+}
+
+TEST(TicketSignerTest, OnlyBinaryTicketsCanBeSigned) {
+    TicketSigner signer = TicketSigner::parse(std::string("3:") + kKey3);
+    std::string base64;
+
+    EXPECT_FALSE(signer.sign(Ticket("TKT-1-1736335200", 7, 1), base64));
+    EXPECT_FALSE(TicketSigner().sign(sampleTicket(), base64));
+}
+
+TEST(TicketSignerTest, EncodeManySignsBinaryTickets) {
+    TicketSigner signer = TicketSigner::parse(std::string("3:") + kKey3);
+    std::vector<Ticket> tickets = {sampleTicket(), Ticket("TKT-1-1736335200", 7, 1)};
+
+    std::string encoded;
+    std::vector<size_t> ends;
+    TicketCodec::encodeMany(tickets, encoded, ends, &signer);
+
+    std::string expected;
+    ASSERT_TRUE(signer.sign(tickets[0], expected));
+    EXPECT_EQ(encoded.substr(0, ends[0]), expected);
+    // Legacy IDs have no binary form and stay unsigned
+    EXPECT_EQ(encoded.substr(ends[0], ends[1] - ends[0]), tickets[1].toBase64());
+}
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+TEST(TicketSignerTest, ParseKeyring) {
+    TicketSigner signer = TicketSigner::parse(std::string(" 4:") + kKey4 + " , 3:" + kKey3, "4");
+    EXPECT_TRUE(signer.hasKeys());
+    EXPECT_TRUE(signer.canSign());
+    EXPECT_EQ(signer.activeKey(), 4);
+
+    TicketSigner empty = TicketSigner::parse("");
+    EXPECT_FALSE(empty.hasKeys());
+    EXPECT_FALSE(empty.canSign());
+}
+
+TEST(TicketSignerTest, InvalidKeyringRejected) {
+    EXPECT_THROW(TicketSigner::parse("3"), std::invalid_argument);
+    EXPECT_THROW(TicketSigner::parse(std::string("16:") + kKey3), std::invalid_argument);
+    EXPECT_THROW(TicketSigner::parse("3:0011"), std::invalid_argument);
+    EXPECT_THROW(TicketSigner::parse(std::string("3:") + kKey3 + "0"), std::invalid_argument);
+    EXPECT_THROW(TicketSigner::parse(std::string("3:zz") + (kKey3 + 2)), std::invalid_argument);
+    EXPECT_THROW(TicketSigner::parse(std::string("3:") + kKey3, "5"), std::invalid_argument);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
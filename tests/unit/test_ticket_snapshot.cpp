@@ -0,0 +1,276 @@
+// tests/unit/test_ticket_snapshot.cpp
+// Unit tests for the binary ticket snapshot and the CSV stock layout
+
+#include <gtest/gtest.h>
+#include "ticket_snapshot.h"
+#include "ticket_csv.h"
+#include "csv_ticket_loader.h"
+#include "ticket_store.h"
+#include "ticket_id.h"
+#include <fstream>
+#include <cstddef>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+/**
+ * Test fixture: temporary directory for snapshot files
+ */
+class TicketSnapshotTest : public ::testing::Test {
+protected:
+    std::string dir_;
+    std::string bin_;
+    std::string csv_;
+
+    void SetUp() override {
+        char tmpl[] = "/tmp/ticket_snapshot_XXXXXX";
+        dir_ = mkdtemp(tmpl);
+        bin_ = dir_ + "/tickets.bin";
+        csv_ = dir_ + "/tickets.csv";
+    }
+
+    void TearDown() override {
+        std::remove(bin_.c_str());
+        std::remove(csv_.c_str());
+        rmdir(dir_.c_str());
+    }
+
+    static std::vector<Ticket> sampleTickets() {
+        return {
+            Ticket("TKT-1-1704623400123456789", "2024-01-07T10:30:00", 7, 1),
+            Ticket("TKT-2-1704623401123456789", "2024-01-07T10:30:01", 30, 5),
+            Ticket("TKT-3-1704623402123456789", "2024-01-07T10:30:02", 1, 9999),
+        };
+    }
+};
+
+// ============================================================================
+// BINARY SNAPSHOT
+// ============================================================================
+
+TEST_F(TicketSnapshotTest, WriteAndMapRoundTrip) {
+    std::vector<Ticket> tickets = sampleTickets();
+    TicketSnapshot::write(bin_, tickets);
+
+    ASSERT_TRUE(TicketSnapshot::isSnapshotFile(bin_));
+    TicketSnapshot snapshot(bin_);
+    ASSERT_EQ(snapshot.size(), tickets.size());
+
+    for (size_t i = 0; i < tickets.size(); i++) {
+        Ticket loaded = snapshot.ticket(i);
+        EXPECT_EQ(loaded.getId(), tickets[i].getId());
+        EXPECT_EQ(loaded.getCreationDate(), tickets[i].getCreationDate());
+        EXPECT_EQ(loaded.getValidityDays(), tickets[i].getValidityDays());
+        EXPECT_EQ(loaded.getLineNumber(), tickets[i].getLineNumber());
+    }
+}
+
+TEST_F(TicketSnapshotTest, EmptySnapshot) {
+    TicketSnapshot::write(bin_, {});
+
+    TicketSnapshot snapshot(bin_);
+    EXPECT_EQ(snapshot.size(), 0u);
+}
+
+TEST_F(TicketSnapshotTest, CsvFileIsNotASnapshot) {
+    TicketCsv::writeFile(csv_, sampleTickets());
+
+    EXPECT_FALSE(TicketSnapshot::isSnapshotFile(csv_));
+    EXPECT_THROW(TicketSnapshot snapshot(csv_), std::runtime_error);
+}
+
+TEST_F(TicketSnapshotTest, TruncatedSnapshotRejected) {
+    TicketSnapshot::write(bin_, sampleTickets());
+    ASSERT_EQ(truncate(bin_.c_str(), 64 + 64 * 2), 0);
+
+    EXPECT_THROW(TicketSnapshot snapshot(bin_), std::runtime_error);
+}
+
+TEST_F(TicketSnapshotTest, UnknownVersionRejected) {
+    TicketSnapshot::write(bin_, sampleTickets());
+    {
+        std::fstream file(bin_, std::ios::in | std::ios::out | std::ios::binary);
+        uint32_t version = TicketSnapshot::kVersion + 1;
+        file.seekp(8);
+        file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    }
+
+    EXPECT_THROW(TicketSnapshot snapshot(bin_), std::runtime_error);
+}
+
+TEST_F(TicketSnapshotTest, LoadIntoStoreMatchesTickets) {
+    // Snowflake and legacy IDs, enough records to bucket on several threads
+    std::vector<Ticket> tickets;
+    for (int i = 0; i < 20000; i++) {
+        std::string id = i % 4 == 0 ? "TKT-" + std::to_string(i) : TicketIdAllocator::encode(1000 + i);
+        tickets.emplace_back(id, 1704623400 + i, 1 + i % 30, i % 100);
+    }
+    TicketSnapshot::write(bin_, tickets);
+
+    TicketStore store(16);
+    ASSERT_TRUE(store.insert(tickets[7]));  // Already loaded, e.g. from elsewhere
+    TicketSnapshot snapshot(bin_);
+    EXPECT_EQ(snapshot.loadInto(store, 4), tickets.size() - 1);
+    EXPECT_EQ(store.size(), tickets.size());
+
+    for (size_t i = 0; i < tickets.size(); i += 997) {
+        Ticket loaded;
+        ASSERT_TRUE(store.find(tickets[i].getId(), loaded)) << tickets[i].getId();
+        EXPECT_EQ(loaded.getCreationTime(), tickets[i].getCreationTime());
+        EXPECT_EQ(loaded.getValidityDays(), tickets[i].getValidityDays());
+        EXPECT_EQ(loaded.getLineNumber(), tickets[i].getLineNumber());
+    }
+}
+
+TEST_F(TicketSnapshotTest, LongIdsStoredOutOfLine) {
+    std::vector<Ticket> tickets = {
+        Ticket("123e4567-e89b-12d3-a456-426614174000", "2024-01-07T10:30:00", 7, 1),  // Fills the field
+        Ticket(std::string(40, 'X'), "2024-01-07T10:30:01", 7, 2),
+        Ticket("TKT-3", "2024-01-07T10:30:02", 7, 3),
+        Ticket(std::string(TicketStore::kMaxLegacyIdLength, 'Y'), "2024-01-07T10:30:03", 7, 4),
+    };
+    TicketSnapshot::write(bin_, tickets);
+
+    TicketSnapshot snapshot(bin_);
+    ASSERT_EQ(snapshot.size(), tickets.size());
+    for (size_t i = 0; i < tickets.size(); i++) {
+        EXPECT_EQ(snapshot.ticket(i).getId(), tickets[i].getId());
+    }
+
+    TicketStore store(4);
+    EXPECT_EQ(snapshot.loadInto(store), tickets.size());
+    Ticket loaded;
+    ASSERT_TRUE(store.find(std::string(40, 'X'), loaded));
+    EXPECT_EQ(loaded.getLineNumber(), 2);
+    EXPECT_TRUE(store.contains(tickets[3].getId()));
+}
+
+TEST_F(TicketSnapshotTest, LongIdOutsideFileRejected) {
+    TicketSnapshot::write(bin_, {Ticket(std::string(40, 'X'), "2024-01-07T10:30:00", 7, 1)});
+    {
+        std::fstream file(bin_, std::ios::in | std::ios::out | std::ios::binary);
+        uint64_t offset = 1;  // Runs one byte past the long ID area
+        file.seekp(sizeof(TicketSnapshotHeader) + offsetof(TicketSnapshotRecord, longIdOffset));
+        file.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+    }
+
+    TicketSnapshot snapshot(bin_);
+    TicketStore store(4);
+    EXPECT_THROW(snapshot.loadInto(store), std::runtime_error);
+    EXPECT_THROW(snapshot.ticket(0), std::runtime_error);
+    EXPECT_EQ(store.size(), 0u);
+}
+
+TEST_F(TicketSnapshotTest, SnapshotPathByExtension) {
+    EXPECT_TRUE(TicketSnapshot::isSnapshotPath("data/tickets.bin"));
+    EXPECT_FALSE(TicketSnapshot::isSnapshotPath("data/tickets.csv"));
+}
+
+// ============================================================================
+// CSV LAYOUT
+// ============================================================================
+
+TEST_F(TicketSnapshotTest, CsvRoundTrip) {
+    TicketCsv::writeFile(csv_, sampleTickets());
+
+    std::vector<Ticket> loaded;
+    CsvTicketLoader::Stats stats;
+    ASSERT_TRUE(CsvTicketLoader(2).load(csv_, loaded, stats));
+
+    EXPECT_EQ(stats.badRows, 0u);
+    ASSERT_EQ(loaded.size(), 3u);
+    EXPECT_EQ(loaded[2].getId(), "TKT-3-1704623402123456789");
+    EXPECT_EQ(loaded[2].getCreationDate(), "2024-01-07T10:30:02");
+    EXPECT_EQ(loaded[2].getLineNumber(), 9999);
+}
+
+TEST_F(TicketSnapshotTest, CsvMalformedRowsCounted) {
+    std::ofstream(csv_) << TicketCsv::kHeader << "\n"
+                        << "TKT-1,2024-01-07T10:30:00,7,1\n"
+                        << "TKT-2,2024-01-07T10:30:00,seven,1\n"
+                        << "TKT-3,2024-01\n";
+
+    std::vector<Ticket> loaded;
+    CsvTicketLoader::Stats stats;
+    ASSERT_TRUE(CsvTicketLoader(1).load(csv_, loaded, stats));
+
+    EXPECT_EQ(loaded.size(), 1u);
+    EXPECT_EQ(stats.rows, 1u);
+    EXPECT_EQ(stats.badRows, 2u);
+}
+
+TEST_F(TicketSnapshotTest, MissingCsvFile) {
+    std::vector<Ticket> loaded;
+    CsvTicketLoader::Stats stats;
+
+    EXPECT_FALSE(CsvTicketLoader().load(csv_, loaded, stats));
+}
+
+TEST_F(TicketSnapshotTest, ParseRowWithoutAllocation) {
+    TicketCsv::Row row;
+
+    ASSERT_TRUE(TicketCsv::parseRow("TKT-1,2024-01-07T10:30:00,7,12\r", row));
+    EXPECT_EQ(row.ticketId, "TKT-1");
+    EXPECT_EQ(row.creationTime, 1704623400);
+    EXPECT_EQ(row.validityDays, 7);
+    EXPECT_EQ(row.lineNumber, 12);
+
+    EXPECT_FALSE(TicketCsv::parseRow("TKT-1,2024-01-07T10:30:00,7x,12", row));
+    EXPECT_FALSE(TicketCsv::parseRow("TKT-1,2024-13-07T10:30:00,7,12", row));
+    EXPECT_FALSE(TicketCsv::parseRow("TKT-1,07/01/2024 10:30,7,12", row));
+    EXPECT_FALSE(TicketCsv::parseRow(",2024-01-07T10:30:00,7,12", row));
+}
+
+// ============================================================================
+// PARALLEL LOADER
+// ============================================================================
+
+TEST_F(TicketSnapshotTest, ParallelLoadMatchesFileOrder) {
+    std::vector<Ticket> tickets;
+    for (int i = 0; i < 5000; i++) {
+        tickets.emplace_back("TKT-" + std::to_string(i), "2024-01-07T10:30:00", 7, i % 40);
+    }
+    TicketCsv::writeFile(csv_, tickets);
+
+    std::vector<Ticket> loaded;
+    CsvTicketLoader::Stats stats;
+    ASSERT_TRUE(CsvTicketLoader(7).load(csv_, loaded, stats));
+
+    ASSERT_EQ(loaded.size(), tickets.size());
+    for (size_t i = 0; i < tickets.size(); i++) {
+        ASSERT_EQ(loaded[i].getId(), tickets[i].getId());
+        ASSERT_EQ(loaded[i].getLineNumber(), tickets[i].getLineNumber());
+    }
+}
+
+TEST_F(TicketSnapshotTest, ParallelLoadIntoStoreSkipsDuplicates) {
+    std::ofstream file(csv_);
+    file << TicketCsv::kHeader << "\n";
+    for (int i = 0; i < 3000; i++) {
+        file << "TKT-" << i << ",2024-01-07T10:30:00,7,1\n";
+    }
+    file << "TKT-5,2024-01-07T10:30:00,30,2\n";
+    file.close();
+
+    TicketStore store(16);
+    CsvTicketLoader::Stats stats;
+    ASSERT_TRUE(CsvTicketLoader(4).loadInto(csv_, store, stats));
+
+    EXPECT_EQ(stats.rows, 3001u);
+    EXPECT_EQ(stats.duplicates, 1u);
+    EXPECT_EQ(store.size(), 3000u);
+
+    Ticket first;
+    ASSERT_TRUE(store.find("TKT-5", first));
+    EXPECT_EQ(first.getValidityDays(), 7);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
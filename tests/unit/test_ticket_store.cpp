@@ -0,0 +1,253 @@
+// tests/unit/test_ticket_store.cpp
+// Unit tests for the sharded in-memory ticket store
+
+#include <gtest/gtest.h>
+#include "ticket_store.h"
+#include "ticket_id.h"
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <set>
+
+/**
+ * Test fixture for TicketStore
+ */
+class TicketStoreTest : public ::testing::Test {
+protected:
+    TicketStore store_{16};
+};
+
+// ============================================================================
+// BASIC OPERATIONS
+// ============================================================================
+
+TEST_F(TicketStoreTest, ShardCountRoundedToPowerOfTwo) {
+    TicketStore store(20);
+
+    EXPECT_EQ(store.shardCount(), 32u);
+}
+
+TEST_F(TicketStoreTest, InsertAndFind) {
+    ASSERT_TRUE(store_.insert(Ticket("TKT-001", 7, 3)));
+
+    Ticket found;
+    EXPECT_TRUE(store_.contains("TKT-001"));
+    ASSERT_TRUE(store_.find("TKT-001", found));
+    EXPECT_EQ(found.getValidityDays(), 7);
+    EXPECT_EQ(found.getLineNumber(), 3);
+
+    EXPECT_FALSE(store_.contains("TKT-002"));
+    EXPECT_FALSE(store_.find("TKT-002", found));
+}
+
+TEST_F(TicketStoreTest, DuplicateIdRejected) {
+    ASSERT_TRUE(store_.insert(Ticket("TKT-001", 7, 3)));
+
+    EXPECT_FALSE(store_.insert(Ticket("TKT-001", 30, 1)));
+    EXPECT_EQ(store_.size(), 1u);
+}
+
+TEST_F(TicketStoreTest, InsertManySkipsDuplicates) {
+    ASSERT_TRUE(store_.insert(Ticket("TKT-5", 7, 1)));
+
+    std::vector<Ticket> batch;
+    for (int i = 0; i < 100; i++) {
+        batch.emplace_back("TKT-" + std::to_string(i), 7, 1);
+    }
+
+    EXPECT_EQ(store_.insertMany(batch), 99u);
+    EXPECT_EQ(store_.size(), 100u);
+    EXPECT_TRUE(store_.contains("TKT-99"));
+}
+
+TEST_F(TicketStoreTest, FindManyCopiesRecords) {
+    for (int i = 0; i < 50; i++) {
+        ASSERT_TRUE(store_.insert(Ticket("TKT-" + std::to_string(i * 2), 7, i * 2)));
+    }
+
+    std::vector<std::string> ids;
+    for (int i = 0; i < 100; i++) {
+        ids.push_back("TKT-" + std::to_string(i));
+    }
+    std::vector<std::string_view> views(ids.begin(), ids.end());
+
+    std::vector<TicketRecord> records;
+    std::vector<bool> found = store_.findMany(views, records);
+    ASSERT_EQ(found.size(), 100u);
+    ASSERT_EQ(records.size(), 100u);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(found[i], i % 2 == 0) << ids[i];
+        if (found[i]) {
+            EXPECT_EQ(records[i].lineNumber, i) << ids[i];
+        }
+    }
+    EXPECT_TRUE(store_.findMany({}, records).empty());
+    EXPECT_TRUE(records.empty());
+}
+
+TEST_F(TicketStoreTest, SnapshotAndForEachSeeEveryTicket) {
+    store_.reserve(1000);
+    for (int i = 0; i < 1000; i++) {
+        ASSERT_TRUE(store_.insert(Ticket("TKT-" + std::to_string(i), 7, 1)));
+    }
+
+    std::set<std::string> visited;
+    store_.forEach([&visited](const Ticket& ticket) { visited.insert(ticket.getId()); });
+
+    EXPECT_EQ(store_.size(), 1000u);
+    EXPECT_EQ(store_.snapshot().size(), 1000u);
+    EXPECT_EQ(visited.size(), 1000u);
+}
+
+TEST_F(TicketStoreTest, PagesCoverEveryTicketOnce) {
+    for (int i = 0; i < 1000; i++) {
+        ASSERT_TRUE(store_.insert(Ticket("TKT-" + std::to_string(i), 7, 1)));
+    }
+
+    std::vector<size_t> bounds = store_.shardSizes();
+    TicketStore::Cursor cursor;
+    std::set<std::string> visited;
+    std::vector<Ticket> page;
+    int pages = 0;
+
+    while (cursor.shard < store_.shardCount()) {
+        page.clear();
+        size_t copied = store_.copyPage(cursor, bounds, 64, page);
+        ASSERT_EQ(copied, page.size());
+        ASSERT_LE(copied, 64u);
+        for (const auto& ticket : page) visited.insert(ticket.getId());
+        pages++;
+    }
+
+    EXPECT_EQ(visited.size(), 1000u);
+    EXPECT_GE(pages, 16);
+}
+
+TEST_F(TicketStoreTest, PagesIgnoreTicketsAddedAfterBoundsWereTaken) {
+    for (int i = 0; i < 100; i++) {
+        ASSERT_TRUE(store_.insert(Ticket("TKT-" + std::to_string(i), 7, 1)));
+    }
+    std::vector<size_t> bounds = store_.shardSizes();
+
+    for (int i = 100; i < 200; i++) {
+        ASSERT_TRUE(store_.insert(Ticket("TKT-" + std::to_string(i), 7, 1)));
+    }
+
+    TicketStore::Cursor cursor;
+    std::vector<Ticket> all;
+    while (cursor.shard < store_.shardCount()) {
+        store_.copyPage(cursor, bounds, 7, all);
+    }
+
+    EXPECT_EQ(all.size(), 100u);
+}
+
+// ============================================================================
+// PACKED RECORDS
+// ============================================================================
+
+TEST_F(TicketStoreTest, SnowflakeAndLegacyIdsRoundTrip) {
+    TicketIdAllocator allocator(2);
+    std::string snowflake = allocator.nextString();
+
+    ASSERT_TRUE(store_.insert(Ticket(snowflake, 1704623400, 30, 4)));
+    ASSERT_TRUE(store_.insert(Ticket("TKT-1-1736335200", 1704623401, 7, 5)));
+
+    Ticket found;
+    ASSERT_TRUE(store_.find(snowflake, found));
+    EXPECT_EQ(found.getId(), snowflake);
+    EXPECT_EQ(found.getCreationTime(), 1704623400);
+    EXPECT_EQ(found.getValidityDays(), 30);
+    EXPECT_EQ(found.getLineNumber(), 4);
+
+    ASSERT_TRUE(store_.find("TKT-1-1736335200", found));
+    EXPECT_EQ(found.getId(), "TKT-1-1736335200");
+    EXPECT_EQ(found.getCreationTime(), 1704623401);
+
+    TicketRecord record;
+    ASSERT_TRUE(store_.find(snowflake, record));
+    EXPECT_FALSE(record.hasLegacyId());
+    EXPECT_EQ(record.id, TicketRecord::packId(snowflake));
+    ASSERT_TRUE(store_.find("TKT-1-1736335200", record));
+    EXPECT_TRUE(record.hasLegacyId());
+}
+
+TEST_F(TicketStoreTest, NonCanonicalSpellingIsADifferentId) {
+    // Lower case decodes to the same value but must keep its own identity
+    ASSERT_TRUE(store_.insert(Ticket("00BXJ7Q2R0G01", 7, 1)));
+    ASSERT_TRUE(store_.insert(Ticket("00bxj7q2r0g01", 7, 2)));
+
+    Ticket found;
+    ASSERT_TRUE(store_.find("00bxj7q2r0g01", found));
+    EXPECT_EQ(found.getId(), "00bxj7q2r0g01");
+    EXPECT_EQ(found.getLineNumber(), 2);
+    EXPECT_FALSE(store_.insert(Ticket("00BXJ7Q2R0G01", 7, 3)));
+    EXPECT_EQ(store_.size(), 2u);
+}
+
+TEST_F(TicketStoreTest, CsvRowsInsertWithoutTickets) {
+    std::vector<TicketCsv::Row> rows(2);
+    rows[0].ticketId = "TKT-A";
+    rows[0].creationTime = 1704623400;
+    rows[0].validityDays = 3;
+    rows[0].lineNumber = 9;
+    rows[1] = rows[0];
+
+    size_t shard = store_.shardIndex("TKT-A");
+    EXPECT_EQ(store_.insertIntoShard(shard, rows), 1u);
+
+    Ticket found;
+    ASSERT_TRUE(store_.find("TKT-A", found));
+    EXPECT_EQ(found.getValidityDays(), 3);
+    EXPECT_EQ(found.getLineNumber(), 9);
+}
+
+TEST_F(TicketStoreTest, OverlongLegacyIdRejected) {
+    EXPECT_FALSE(store_.insert(Ticket(std::string(TicketStore::kMaxLegacyIdLength + 1, 'x'), 7, 1)));
+    EXPECT_TRUE(store_.insert(Ticket(std::string(TicketStore::kMaxLegacyIdLength, 'x'), 7, 1)));
+    EXPECT_TRUE(store_.contains(std::string(TicketStore::kMaxLegacyIdLength, 'x')));
+}
+
+// ============================================================================
+// CONCURRENCY
+// ============================================================================
+
+TEST_F(TicketStoreTest, ConcurrentWritersAndReaders) {
+    ASSERT_TRUE(store_.insert(Ticket("TKT-SEED", 7, 1)));
+
+    std::atomic<bool> done(false);
+    std::atomic<int> missedSeed(0);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; r++) {
+        readers.emplace_back([&] {
+            while (!done) {
+                if (!store_.contains("TKT-SEED")) missedSeed++;
+            }
+        });
+    }
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 4; w++) {
+        writers.emplace_back([this, w] {
+            for (int i = 0; i < 2000; i++) {
+                store_.insert(Ticket("TKT-" + std::to_string(w) + "-" + std::to_string(i), 7, 1));
+            }
+        });
+    }
+    for (auto& writer : writers) writer.join();
+    done = true;
+    for (auto& reader : readers) reader.join();
+
+    EXPECT_EQ(missedSeed.load(), 0);
+    EXPECT_EQ(store_.size(), 8001u);
+    EXPECT_TRUE(store_.contains("TKT-3-1999"));
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,168 @@
+// tests/unit/test_ticket_validator.cpp
+// Unit tests for the back-office ticket verdict
+
+#include <gtest/gtest.h>
+#include "ticket_validator.h"
+#include "ticket_id.h"
+#include "base64.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* const kKey3 = "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f";
+
+constexpr int64_t kCreated = 1704623400;       // 2024-01-07T10:30:00Z
+constexpr int64_t kNow = kCreated + 86400;     // One day later
+
+Ticket snowflakeTicket(int validityDays = 7) {
+    return Ticket(TicketIdAllocator::encode(12345), kCreated, validityDays, 42);
+}
+
+// Signed ticket with its MAC removed, the signed flag cleared and its
+// validity raised: what an attacker can build from a genuine ticket
+std::string strippedAndExtended(const std::string& signedBase64) {
+    std::string payload;
+    Base64::decode(signedBase64, payload);
+    payload.resize(Ticket::kWireSize);
+    payload[1] = 0;     // flags
+    payload[2] = 100;   // validityDays, low byte
+    payload[3] = 0;
+    return Base64::encode(payload);
+}
+
+} // namespace
+
+// ============================================================================
+// SIGNATURES
+// ============================================================================
+
+TEST(TicketValidatorTest, SignedTicketIsValid) {
+    TicketStore store;
+    TicketSigner signer = TicketSigner::parse(std::string("3:") + kKey3);
+    TicketValidator validator(store);
+    ASSERT_TRUE(store.insert(snowflakeTicket()));
+
+    std::string base64;
+    ASSERT_TRUE(signer.sign(snowflakeTicket(), base64));
+    Ticket ticket;
+    TicketSigner::Status signature = signer.verify(base64, ticket);
+
+    TicketValidator::Verdict verdict = validator.check(ticket, signature, kNow);
+    EXPECT_TRUE(verdict.valid);
+    EXPECT_EQ(verdict.message, "Ticket is valid");
+}
+
+TEST(TicketValidatorTest, StrippedMacWithExtendedValidityRejected) {
+    TicketStore store;
+    TicketSigner signer = TicketSigner::parse(std::string("3:") + kKey3);
+    TicketValidator validator(store);
+    ASSERT_TRUE(store.insert(snowflakeTicket(1)));
+
+    std::string base64;
+    ASSERT_TRUE(signer.sign(snowflakeTicket(1), base64));
+    Ticket forged;
+    TicketSigner::Status signature = signer.verify(strippedAndExtended(base64), forged);
+    ASSERT_EQ(signature, TicketSigner::Status::Unsigned);
+    ASSERT_EQ(forged.getValidityDays(), 100);
+
+    // The stored ticket expired a day ago; the forged one claims 100 days
+    TicketValidator::Verdict verdict = validator.check(forged, signature, kNow + 86400);
+    EXPECT_FALSE(verdict.valid);
+    EXPECT_EQ(verdict.message, "Ticket data does not match records");
+}
+
+TEST(TicketValidatorTest, UnsignedTicketSoldBeforeKeyStillAccepted) {
+    TicketStore store;
+    TicketValidator validator(store);
+    ASSERT_TRUE(store.insert(snowflakeTicket(30)));
+    Ticket legacy("TKT-42", kCreated, 7, 3);
+    ASSERT_TRUE(store.insert(legacy));
+
+    EXPECT_TRUE(validator.check(snowflakeTicket(30), TicketSigner::Status::Unsigned, kNow).valid);
+    EXPECT_TRUE(validator.check(legacy, TicketSigner::Status::Unsigned, kNow).valid);
+}
+
+TEST(TicketValidatorTest, BadSignatureRejected) {
+    TicketStore store;
+    TicketValidator validator(store);
+    ASSERT_TRUE(store.insert(snowflakeTicket()));
+
+    TicketValidator::Verdict verdict = validator.check(snowflakeTicket(), TicketSigner::Status::BadSignature, kNow);
+    EXPECT_FALSE(verdict.valid);
+    EXPECT_EQ(verdict.message, "Invalid ticket signature");
+}
+
+// ============================================================================
+// STORED RECORD
+// ============================================================================
+
+TEST(TicketValidatorTest, AlteredFieldsRejectedWithoutSigning) {
+    TicketStore store;
+    TicketValidator validator(store);
+    ASSERT_TRUE(store.insert(snowflakeTicket(1)));
+
+    Ticket extended = snowflakeTicket(100);
+    TicketValidator::Verdict verdict = validator.check(extended, TicketSigner::Status::Unsigned, kNow + 86400);
+    EXPECT_FALSE(verdict.valid);
+    EXPECT_EQ(verdict.message, "Ticket data does not match records");
+
+    Ticket otherLine = snowflakeTicket(1);
+    otherLine.setLineNumber(7);
+    EXPECT_FALSE(validator.check(otherLine, TicketSigner::Status::Unsigned, kNow - 3600).valid);
+}
+
+TEST(TicketValidatorTest, ExpiryComesFromStoredRecord) {
+    TicketStore store;
+    TicketValidator validator(store);
+    ASSERT_TRUE(store.insert(snowflakeTicket(1)));
+
+    EXPECT_TRUE(validator.check(snowflakeTicket(1), TicketSigner::Status::Unsigned, kCreated + 86399).valid);
+    TicketValidator::Verdict verdict = validator.check(snowflakeTicket(1), TicketSigner::Status::Unsigned,
+                                                       kCreated + 86400);
+    EXPECT_FALSE(verdict.valid);
+    EXPECT_EQ(verdict.message, "Ticket expired");
+}
+
+TEST(TicketValidatorTest, UnknownTicketRejected) {
+    TicketStore store;
+    TicketValidator validator(store);
+
+    TicketValidator::Verdict verdict = validator.check(snowflakeTicket(), TicketSigner::Status::Unsigned, kNow);
+    EXPECT_FALSE(verdict.valid);
+    EXPECT_EQ(verdict.message, "Ticket not found in database");
+}
+
+TEST(TicketValidatorTest, CheckManyMatchesCheck) {
+    TicketStore store;
+    TicketSigner signer = TicketSigner::parse(std::string("3:") + kKey3);
+    TicketValidator validator(store);
+    // checkMany reads the real clock
+    ASSERT_TRUE(store.insert(snowflakeTicket(10000)));
+
+    std::string base64;
+    ASSERT_TRUE(signer.sign(snowflakeTicket(10000), base64));
+    Ticket genuine;
+    Ticket forged;
+    Ticket unknown = Ticket(TicketIdAllocator::encode(999), kCreated, 7, 42);
+    std::vector<TicketSigner::Status> signatures = {
+        signer.verify(base64, genuine),
+        signer.verify(strippedAndExtended(base64), forged),
+        TicketSigner::Status::Unsigned
+    };
+
+    std::vector<TicketValidator::Verdict> verdicts = validator.checkMany({&genuine, &forged, &unknown}, signatures);
+    ASSERT_EQ(verdicts.size(), 3u);
+    EXPECT_TRUE(verdicts[0].valid);
+    EXPECT_EQ(verdicts[1].message, "Ticket data does not match records");
+    EXPECT_EQ(verdicts[2].message, "Ticket not found in database");
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
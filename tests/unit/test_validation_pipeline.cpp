@@ -0,0 +1,163 @@
+// tests/unit/test_validation_pipeline.cpp
+// Unit tests for the gate's bounded validation pipeline
+
+#include <gtest/gtest.h>
+#include "validation_pipeline.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Blocks tasks until opened
+class Latch {
+public:
+    void open() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            open_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return open_; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool open_ = false;
+};
+
+ValidationPipeline::Config config(size_t workers, size_t queueCapacity) {
+    ValidationPipeline::Config config;
+    config.workers = workers;
+    config.queueCapacity = queueCapacity;
+    return config;
+}
+
+} // namespace
+
+// ============================================================================
+// ORDERING AND CONCURRENCY
+// ============================================================================
+
+TEST(ValidationPipelineTest, SameKeyRunsInOrder) {
+    ValidationPipeline pipeline(config(4, 8));
+    std::mutex mutex;
+    std::vector<int> order;
+
+    for (int i = 0; i < 200; i++) {
+        pipeline.submit(42, [&, i] {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(i);
+        });
+    }
+    pipeline.stop();
+
+    ASSERT_EQ(order.size(), 200u);
+    for (int i = 0; i < 200; i++) {
+        EXPECT_EQ(order[i], i);
+    }
+}
+
+TEST(ValidationPipelineTest, SlowTicketDoesNotBlockOthers) {
+    ValidationPipeline pipeline(config(2, 8));
+    Latch slow;
+    std::promise<void> otherDone;
+
+    pipeline.submit(0, [&] { slow.wait(); });
+    pipeline.submit(1, [&] { otherDone.set_value(); });
+
+    EXPECT_EQ(otherDone.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    slow.open();
+}
+
+TEST(ValidationPipelineTest, InFlightBoundedByWorkers) {
+    ValidationPipeline pipeline(config(3, 16));
+    std::atomic<int> running{0};
+    std::atomic<int> peak{0};
+
+    for (uint64_t i = 0; i < 60; i++) {
+        pipeline.submit(i, [&] {
+            int now = ++running;
+            int previous = peak.load();
+            while (now > previous && !peak.compare_exchange_weak(previous, now)) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            --running;
+        });
+    }
+    pipeline.stop();
+
+    EXPECT_LE(peak.load(), 3);
+    EXPECT_EQ(pipeline.stats().completed, 60u);
+}
+
+// ============================================================================
+// BACKPRESSURE AND SHUTDOWN
+// ============================================================================
+
+TEST(ValidationPipelineTest, SubmitBlocksWhileQueueFull) {
+    ValidationPipeline pipeline(config(1, 2));
+    Latch gate;
+
+    pipeline.submit(0, [&] { gate.wait(); });  // Running
+    pipeline.submit(0, [] {});                 // Queued
+    pipeline.submit(0, [] {});                 // Queued, queue now full
+    // Give the worker time to pick up the first task
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    auto blocked = std::async(std::launch::async, [&] { return pipeline.submit(0, [] {}); });
+    EXPECT_EQ(blocked.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+
+    gate.open();
+    EXPECT_TRUE(blocked.get());
+    pipeline.stop();
+
+    ValidationPipeline::Stats stats = pipeline.stats();
+    EXPECT_EQ(stats.submitted, 4u);
+    EXPECT_EQ(stats.completed, 4u);
+    EXPECT_GE(stats.stalls, 1u);
+    EXPECT_EQ(stats.queued, 0u);
+}
+
+TEST(ValidationPipelineTest, StopDrainsQueueAndRejectsNewTasks) {
+    ValidationPipeline pipeline(config(2, 64));
+    std::atomic<int> done{0};
+
+    for (uint64_t i = 0; i < 50; i++) {
+        pipeline.submit(i, [&] { done++; });
+    }
+    pipeline.stop();
+
+    EXPECT_EQ(done.load(), 50);
+    EXPECT_FALSE(pipeline.submit(0, [&] { done++; }));
+    EXPECT_EQ(done.load(), 50);
+}
+
+TEST(ValidationPipelineTest, ThrowingTaskDoesNotStopWorker) {
+    ValidationPipeline pipeline(config(1, 4));
+    std::atomic<bool> ran{false};
+
+    pipeline.submit(0, [] { throw std::runtime_error("Back-Office reply malformed"); });
+    pipeline.submit(0, [&] { ran = true; });
+    pipeline.stop();
+
+    EXPECT_TRUE(ran.load());
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
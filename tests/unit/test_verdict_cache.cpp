@@ -0,0 +1,174 @@
+// tests/unit/test_verdict_cache.cpp
+// Unit tests for the gate's online verdict cache
+
+#include <gtest/gtest.h>
+#include "verdict_cache.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int64_t kNow = 1760000000000;    // ms since the Unix epoch
+constexpr int64_t kDay = 86400000;
+constexpr int64_t kExpiry = kNow + 7 * kDay;
+
+VerdictCache::Config config(size_t maxBytes, int64_t ttlMs) {
+    VerdictCache::Config config;
+    config.maxBytes = maxBytes;
+    config.ttl = std::chrono::milliseconds(ttlMs);
+    return config;
+}
+
+VerdictCache::Verdict validVerdict() {
+    return {true, "Ticket is valid"};
+}
+
+} // namespace
+
+// ============================================================================
+// HITS AND MISSES
+// ============================================================================
+
+TEST(VerdictCacheTest, RepeatTapHits) {
+    VerdictCache cache(config(1 << 20, 60000));
+    VerdictCache::Verdict verdict;
+
+    EXPECT_FALSE(cache.lookup("00BXJ7Q2R0G01", 1, kNow, verdict));
+    cache.store("00BXJ7Q2R0G01", 1, validVerdict(), kExpiry, kNow);
+
+    ASSERT_TRUE(cache.lookup("00BXJ7Q2R0G01", 1, kNow + 1000, verdict));
+    EXPECT_TRUE(verdict.valid);
+    EXPECT_EQ(verdict.message, "Ticket is valid");
+
+    VerdictCache::Stats stats = cache.stats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_DOUBLE_EQ(stats.hitRate(), 0.5);
+}
+
+TEST(VerdictCacheTest, DifferentFingerprintMisses) {
+    VerdictCache cache(config(1 << 20, 60000));
+    VerdictCache::Verdict verdict;
+
+    cache.store("00BXJ7Q2R0G01", 1, validVerdict(), kExpiry, kNow);
+    EXPECT_FALSE(cache.lookup("00BXJ7Q2R0G01", 2, kNow, verdict));
+    // The mismatched entry is gone
+    EXPECT_FALSE(cache.lookup("00BXJ7Q2R0G01", 1, kNow, verdict));
+}
+
+// ============================================================================
+// EXPIRY
+// ============================================================================
+
+TEST(VerdictCacheTest, EntryExpiresAfterTtl) {
+    VerdictCache cache(config(1 << 20, 60000));
+    VerdictCache::Verdict verdict;
+
+    cache.store("A", 1, validVerdict(), kExpiry, kNow);
+    EXPECT_TRUE(cache.lookup("A", 1, kNow + 59999, verdict));
+    EXPECT_FALSE(cache.lookup("A", 1, kNow + 60000, verdict));
+    EXPECT_EQ(cache.stats().entries, 0u);
+}
+
+TEST(VerdictCacheTest, EntryNeverOutlivesTicket) {
+    VerdictCache cache(config(1 << 20, 60000));
+    VerdictCache::Verdict verdict;
+
+    cache.store("A", 1, validVerdict(), kNow + 5000, kNow);
+    EXPECT_TRUE(cache.lookup("A", 1, kNow + 4999, verdict));
+    EXPECT_FALSE(cache.lookup("A", 1, kNow + 5000, verdict));
+
+    // Already expired: not stored at all
+    cache.store("B", 1, validVerdict(), kNow, kNow);
+    EXPECT_EQ(cache.stats().entries, 0u);
+}
+
+// ============================================================================
+// MEMORY BOUND
+// ============================================================================
+
+TEST(VerdictCacheTest, EvictsLeastRecentlyUsedWithinBudget) {
+    VerdictCache probe(config(1 << 20, 60000));
+    probe.store("T0", 1, validVerdict(), kExpiry, kNow);
+    size_t entryBytes = probe.stats().bytes;
+    ASSERT_GT(entryBytes, 0u);
+
+    VerdictCache cache(config(3 * entryBytes, 60000));
+    VerdictCache::Verdict verdict;
+    cache.store("T1", 1, validVerdict(), kExpiry, kNow);
+    cache.store("T2", 1, validVerdict(), kExpiry, kNow);
+    cache.store("T3", 1, validVerdict(), kExpiry, kNow);
+    EXPECT_TRUE(cache.lookup("T1", 1, kNow, verdict));  // T2 is now the oldest
+
+    cache.store("T4", 1, validVerdict(), kExpiry, kNow);
+
+    VerdictCache::Stats stats = cache.stats();
+    EXPECT_EQ(stats.entries, 3u);
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_LE(stats.bytes, 3 * entryBytes);
+    EXPECT_FALSE(cache.lookup("T2", 1, kNow, verdict));
+    EXPECT_TRUE(cache.lookup("T1", 1, kNow, verdict));
+    EXPECT_TRUE(cache.lookup("T4", 1, kNow, verdict));
+}
+
+TEST(VerdictCacheTest, ReplacingEntryKeepsByteCount) {
+    VerdictCache cache(config(1 << 20, 60000));
+    cache.store("A", 1, validVerdict(), kExpiry, kNow);
+    size_t bytes = cache.stats().bytes;
+
+    cache.store("A", 1, validVerdict(), kExpiry, kNow + 1000);
+    EXPECT_EQ(cache.stats().entries, 1u);
+    EXPECT_EQ(cache.stats().bytes, bytes);
+}
+
+TEST(VerdictCacheTest, ZeroBudgetOrTtlDisables) {
+    VerdictCache::Verdict verdict;
+    for (VerdictCache::Config cfg : {config(0, 60000), config(1 << 20, 0)}) {
+        VerdictCache cache(cfg);
+        EXPECT_FALSE(cache.enabled());
+        cache.store("A", 1, validVerdict(), kExpiry, kNow);
+        EXPECT_FALSE(cache.lookup("A", 1, kNow, verdict));
+        EXPECT_EQ(cache.stats().entries, 0u);
+        EXPECT_EQ(cache.stats().misses, 0u);
+    }
+}
+
+// ============================================================================
+// CONCURRENCY
+// ============================================================================
+
+TEST(VerdictCacheTest, ConcurrentWorkers) {
+    VerdictCache probe(config(1 << 20, 60000));
+    probe.store("T0", 1, validVerdict(), kExpiry, kNow);
+    size_t budget = 50 * probe.stats().bytes;
+
+    VerdictCache cache(config(budget, 60000));
+    std::vector<std::thread> workers;
+    for (int w = 0; w < 4; w++) {
+        workers.emplace_back([&, w] {
+            VerdictCache::Verdict verdict;
+            for (int i = 0; i < 5000; i++) {
+                std::string id = "T" + std::to_string((i * 7 + w) % 200);
+                if (!cache.lookup(id, 1, kNow, verdict)) {
+                    cache.store(id, 1, validVerdict(), kExpiry, kNow);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    VerdictCache::Stats stats = cache.stats();
+    EXPECT_EQ(stats.hits + stats.misses, 20000u);
+    EXPECT_LE(stats.bytes, budget);
+    EXPECT_LE(stats.entries, 50u);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}